@@ -0,0 +1,164 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QImage>
+#include <iostream>
+
+#include <opencv/cv.h>
+
+#include "bgr_swizzle.h"
+
+/* Reference implementation (per-pixel QImage::setPixel) */
+static QImage* IplImage2QImage_reference(IplImage *iplImg)
+{
+    /* Save image dismensions */
+    int h = iplImg->height;
+    int w = iplImg->width;
+
+    /* Get image channels */
+    int channels = iplImg->nChannels;
+
+    /* Allocate destination image */
+    QImage *qimg = new QImage(w, h, QImage::Format_ARGB32);
+
+    /* Get source image data */
+    char *data = iplImg->imageData;
+
+    /* Iterate over image Y axis */
+    for (int y = 0; y < h; y++, data += iplImg->widthStep)
+    {
+        /* Iterate over image X axis */
+        for (int x = 0; x < w; x++)
+        {
+            /* Initialize pixel color containers */
+            char r = 0;
+            char g = 0;
+            char b = 0;
+            char a = 0;
+
+            /* Channels check */
+            if (channels == 1)
+            {
+                r = g = b = data[x * channels];
+            }
+            else if (channels == 3 || channels == 4)
+            {
+                r = data[x * channels + 2];
+                g = data[x * channels + 1];
+                b = data[x * channels];
+            }
+
+            /* Channels check */
+            if (channels == 4)
+            {
+                /* Set alpha channel */
+                a = data[x * channels + 3];
+
+                /* Set pixel */
+                qimg->setPixel(x, y, qRgba(r, g, b, a));
+            }
+            else
+            {
+                /* Set pixel */
+                qimg->setPixel(x, y, qRgb(r, g, b));
+            }
+        }
+    }
+    return qimg;
+}
+
+/* Vectorized implementation */
+static QImage* IplImage2QImage_swizzle(IplImage *iplImg)
+{
+    /* Allocate destination image */
+    QImage *qimg = new QImage(iplImg->width, iplImg->height, QImage::Format_ARGB32);
+
+    /* Convert rows */
+    bgr_swizzle_image( (const uchar*) iplImg->imageData, iplImg->widthStep, iplImg->nChannels, qimg, QThread::idealThreadCount() );
+
+    return qimg;
+}
+
+/* Main function */
+int main(int argc, char *argv[])
+{
+    /* Create application */
+    QCoreApplication a(argc, argv);
+
+    /* Benchmark dimensions (default 10000x5000, 50 megapixels) */
+    int width = argc > 1 ? atoi( argv[1] ) : 10000;
+    int height = argc > 2 ? atoi( argv[2] ) : 5000;
+
+    /* Random generator */
+    CvRNG rng = cvRNG( 0x12345 );
+
+    /* Iterate over supported channels layouts */
+    int layouts[] = { 1, 3, 4 };
+    for( int i = 0; i < 3; i++ )
+    {
+        /* Create random source image */
+        IplImage* source = cvCreateImage( cvSize( width, height ), IPL_DEPTH_8U, layouts[i] );
+        cvRandArr( &rng, source, CV_RAND_UNI, cvScalarAll( 0 ), cvScalarAll( 256 ) );
+
+        /* Time reference implementation */
+        QElapsedTimer timer;
+        timer.start();
+        QImage* reference = IplImage2QImage_reference( source );
+        qint64 reference_time = timer.elapsed();
+
+        /* Time vectorized implementation */
+        timer.restart();
+        QImage* swizzle = IplImage2QImage_swizzle( source );
+        qint64 swizzle_time = timer.elapsed();
+
+        /* Print results */
+        std::cout << layouts[i] << " channel(s): reference " << reference_time << " ms, swizzle " << swizzle_time << " ms, "
+                  << ( *reference == *swizzle ? "identical" : "MISMATCH" ) << std::endl;
+
+        /* Release images */
+        delete reference;
+        delete swizzle;
+        cvReleaseImage( &source );
+    }
+
+    return 0;
+}
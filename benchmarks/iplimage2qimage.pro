@@ -0,0 +1,27 @@
+#-------------------------------------------------
+#
+# IplImage2QImage conversion benchmark
+#
+#-------------------------------------------------
+
+QT       += core gui
+
+TARGET = bench-iplimage2qimage
+TEMPLATE = app
+CONFIG += console
+
+# Compiler flags
+QMAKE_CXXFLAGS += -fopenmp
+
+# Include directories
+INCLUDEPATH += $$PWD/../include/
+
+# Source files
+SOURCES += iplimage2qimage.cpp \
+    ../src/bgr_swizzle.cpp
+
+HEADERS  += ../include/bgr_swizzle.h
+
+# Libraries
+LIBS += -fopenmp \
+    -lopencv_core
@@ -0,0 +1,32 @@
+#-------------------------------------------------
+#
+# Yafdb headless exporter / converter
+#
+#-------------------------------------------------
+
+# No widgets (gui only for QImage)
+QT       += core gui
+QT       -= widgets
+
+TARGET = yafdb-cli
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+# Place binary at build root
+DESTDIR = $$OUT_PWD/..
+
+# Shared settings
+include(../yafdb.pri)
+
+# Source files
+SOURCES += ../src/main_cli.cpp
+
+# Rebuild when core library changes
+PRE_TARGETDEPS += $$YAFDB_CORE_LIB
+
+# Libraries
+LIBS += $$YAFDB_CORE_LIBS \
+    -lopencv_core \
+    -lopencv_imgproc \
+    -lopencv_highgui
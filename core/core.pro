@@ -0,0 +1,68 @@
+#-------------------------------------------------
+#
+# Yafdb core library (no display required)
+#
+#-------------------------------------------------
+
+# No widgets (gui only for QImage)
+QT       += core gui
+QT       -= widgets
+
+TARGET = yafdb-core
+TEMPLATE = lib
+CONFIG += staticlib
+
+# Shared settings
+include(../yafdb.pri)
+
+# Libgnomonic settings
+libgnomonic.commands = make -j -C $$PWD/../libs/libgnomonic/
+
+QMAKE_EXTRA_TARGETS += libgnomonic
+PRE_TARGETDEPS += libgnomonic
+
+# Source files
+SOURCES += ../src/ymlparser.cpp \
+    ../src/ymlstream.cpp \
+    ../src/objectbinary.cpp \
+    ../src/editjournal.cpp \
+    ../src/g2g_point.cpp \
+    ../src/projectioncontext.cpp \
+    ../src/sphereindex.cpp \
+    ../src/objectrecord.cpp \
+    ../src/etg_point.cpp \
+    ../src/utils.cpp \
+    ../src/remapcache.cpp \
+    ../src/imagepyramid.cpp \
+    ../src/etg_kernel.cpp \
+    ../src/bgr_swizzle.cpp \
+    ../src/batchmodes.cpp \
+    ../src/batchoptions.cpp \
+    ../src/exporttask.cpp \
+    ../src/exportpipeline.cpp \
+    ../src/shardwriter.cpp \
+    ../src/exportnamer.cpp \
+    ../src/tileencoder.cpp
+
+HEADERS  += ../include/ymlparser.h \
+    ../include/ymlstream.h \
+    ../include/objectbinary.h \
+    ../include/editjournal.h \
+    ../include/g2g_point.h \
+    ../include/projectioncontext.h \
+    ../include/sphereindex.h \
+    ../include/objectrecord.h \
+    ../include/etg_point.h \
+    ../include/utils.h \
+    ../include/remapcache.h \
+    ../include/imagepyramid.h \
+    ../include/etg_kernel.h \
+    ../include/bgr_swizzle.h \
+    ../include/batchmodes.h \
+    ../include/batchoptions.h \
+    ../include/exporttask.h \
+    ../include/exportpipeline.h \
+    ../include/boundedqueue.h \
+    ../include/shardwriter.h \
+    ../include/exportnamer.h \
+    ../include/tileencoder.h
@@ -0,0 +1,75 @@
+#-------------------------------------------------
+#
+# Yafdb validator (GUI)
+#
+#-------------------------------------------------
+
+QT       += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = yafdb-validate
+TEMPLATE = app
+
+# Place binary at build root
+DESTDIR = $$OUT_PWD/..
+
+# Shared settings
+include(../yafdb.pri)
+
+# Add resources file
+RESOURCES += \
+    ../resources.qrc
+
+# Source files
+SOURCES += ../src/main.cpp \
+    ../src/mainwindow.cpp \
+    ../src/panoramaviewer.cpp \
+    ../src/batchview.cpp \
+    ../src/flowlayout.cpp \
+    ../src/objectitem.cpp \
+    ../src/editview.cpp \
+    ../src/objectrect.cpp \
+    ../src/frameitem.cpp \
+    ../src/renderworker.cpp
+
+HEADERS  += ../include/mainwindow.h \
+    ../include/panoramaviewer.h \
+    ../include/batchview.h \
+    ../include/flowlayout.h \
+    ../include/objectitem.h \
+    ../include/editview.h \
+    ../include/main.h \
+    ../include/objectrect.h \
+    ../include/frameitem.h \
+    ../include/renderworker.h
+
+# Ui forms
+FORMS    += ../ui/mainwindow.ui \
+    ../ui/batchview.ui \
+    ../ui/objectitem.ui \
+    ../ui/editview.ui
+
+# Rebuild when core library changes
+PRE_TARGETDEPS += $$YAFDB_CORE_LIB
+
+# Libraries
+LIBS += $$YAFDB_CORE_LIBS \
+    -lopencv_calib3d \
+    -lopencv_contrib \
+    -lopencv_core \
+    -lopencv_features2d \
+    -lopencv_flann \
+    -lopencv_gpu \
+    -lopencv_highgui \
+    -lopencv_imgproc \
+    -lopencv_legacy \
+    -lopencv_ml \
+    -lopencv_objdetect \
+    -lopencv_ocl \
+    -lopencv_photo \
+    -lopencv_stitching \
+    -lopencv_superres \
+    -lopencv_ts \
+    -lopencv_video \
+    -lopencv_videostab
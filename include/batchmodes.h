@@ -0,0 +1,114 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef BATCHMODES_H
+#define BATCHMODES_H
+
+/* Includes */
+#include <QString>
+#include <QVector>
+#include <QSize>
+#include <QDir>
+#include <QFile>
+#include <QThread>
+#include <QThreadPool>
+#include <QSemaphore>
+#include <QSharedPointer>
+#include <iostream>
+
+#include "ymlparser.h"
+#include "utils.h"
+#include "exporttask.h"
+#include "exportpipeline.h"
+#include "boundedqueue.h"
+#include "shardwriter.h"
+#include "exportnamer.h"
+#include "tileencoder.h"
+
+/* Export options structure */
+struct export_options_struct{
+    float zoom;
+    QSize size;
+    int jobs;
+    int inflight;
+    qint64 shard_size;
+    QString format;
+    int quality;
+};
+
+/* Function to compute the export directory of an object */
+QString exportDirectory(QString exportPath, const ObjectRecord &rect);
+
+/* Function to queue the tiles of a panorama on the export pool */
+void queueTiles(QThreadPool* pool,
+                QSharedPointer<QImage> image,
+                const QVector<ObjectRecord> &records,
+                QString exportPath,
+                export_options_struct options,
+                int warp_threads,
+                ExportNamer* namer,
+                TileEncoder* encoder);
+
+/* Function to check export options */
+bool checkExportOptions(export_options_struct options);
+
+/* Function to export objects of a validated YML as image tiles */
+bool exportObjects(QString sourceImagePath,
+                   QString destinationYMLPath,
+                   QString exportPath,
+                   export_options_struct options);
+
+/* Function to export the objects of every panorama listed in a manifest */
+bool exportManifest(QString manifestPath,
+                    QString exportPath,
+                    export_options_struct options);
+
+/* Function to convert a detector YML into a validator YML */
+bool convertYML(QString sourceImagePath,
+                QString detectorYMLPath,
+                QString destinationYMLPath);
+
+/* Function to convert a validated YML into a binary objects file */
+bool convertYMLToBinary(QString destinationYMLPath,
+                        QString binaryPath);
+
+/* Function to convert a binary objects file into a validated YML */
+bool convertBinaryToYML(QString binaryPath,
+                        QString destinationYMLPath);
+
+#endif // BATCHMODES_H
@@ -0,0 +1,96 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef BATCHOPTIONS_H
+#define BATCHOPTIONS_H
+
+/* Includes */
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QString>
+#include <QStringList>
+#include <QSize>
+#include <QThread>
+#include <iostream>
+
+#include "batchmodes.h"
+
+/* Application working modes struct */
+struct ApplicationMode
+{
+    enum Type
+    {
+        /* Start the standard validator */
+        Validator = 0,
+
+        /* Start the tiles exporter */
+        Exporter = 1,
+
+        /* Start the YML converter */
+        YMLConverter = 2,
+
+        /* Start the YML to binary converter */
+        YMLToBinary = 3,
+
+        /* Start the binary to YML converter */
+        BinaryToYML = 4
+    };
+};
+
+/* Command line arguments structure */
+struct batch_arguments_struct{
+    int mode;
+    QString sourceImagePath;
+    QString detectorYMLPath;
+    QString destinationYMLPath;
+    QString binaryPath;
+    QString exportPath;
+    QString manifestPath;
+    export_options_struct export_options;
+};
+
+/* Function to register command line options (validator mode only offered by the GUI) */
+void addBatchOptions(QCommandLineParser* parser, bool validator);
+
+/* Function to parse and check processed command line options, false if arguments are invalid or missing */
+bool parseBatchOptions(const QCommandLineParser &parser, bool validator, batch_arguments_struct* arguments);
+
+/* Function to run a batch mode (every mode but validator) */
+bool runBatchMode(const batch_arguments_struct &arguments);
+
+#endif // BATCHOPTIONS_H
@@ -0,0 +1,144 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+/* Includes */
+#include <QQueue>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+
+/* Main class (blocking FIFO shared between pipeline stages) */
+template <typename T>
+class BoundedQueue
+{
+
+/* Public functions / variables */
+public:
+
+    /* Constructor */
+    BoundedQueue(int capacity)
+    {
+        /* Assign values */
+        this->capacity = qMax( 1, capacity );
+        this->closed = false;
+    }
+
+    /* Function to append an item, blocks while queue is full */
+    bool push(const T &item)
+    {
+        /* Lock queue */
+        QMutexLocker locker( &this->mutex );
+
+        /* Wait for a free slot */
+        while( !this->closed && this->items.size() >= this->capacity )
+            this->not_full.wait( &this->mutex );
+
+        /* Refuse items once closed */
+        if( this->closed )
+            return false;
+
+        /* Append item */
+        this->items.enqueue( item );
+
+        /* Wake up a consumer */
+        this->not_empty.wakeOne();
+
+        /* Return result */
+        return true;
+    }
+
+    /* Function to take the next item, blocks while queue is empty */
+    bool pop(T* item)
+    {
+        /* Lock queue */
+        QMutexLocker locker( &this->mutex );
+
+        /* Wait for an item */
+        while( !this->closed && this->items.isEmpty() )
+            this->not_empty.wait( &this->mutex );
+
+        /* Closed and drained */
+        if( this->items.isEmpty() )
+            return false;
+
+        /* Take item */
+        *item = this->items.dequeue();
+
+        /* Wake up a producer */
+        this->not_full.wakeOne();
+
+        /* Return result */
+        return true;
+    }
+
+    /* Function to signal that no more items will be pushed */
+    void close()
+    {
+        /* Lock queue */
+        QMutexLocker locker( &this->mutex );
+
+        /* Mark as closed */
+        this->closed = true;
+
+        /* Release every waiting thread */
+        this->not_empty.wakeAll();
+        this->not_full.wakeAll();
+    }
+
+/* Private functions / variables */
+private:
+
+    /* Queued items */
+    QQueue<T> items;
+
+    /* Maximum number of queued items */
+    int capacity;
+
+    /* No more items flag */
+    bool closed;
+
+    /* Synchronization */
+    QMutex mutex;
+    QWaitCondition not_empty;
+    QWaitCondition not_full;
+};
+
+#endif // BOUNDEDQUEUE_H
@@ -0,0 +1,105 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef EDITJOURNAL_H
+#define EDITJOURNAL_H
+
+/* Includes */
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QByteArray>
+#include <QHash>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QString>
+#include <QVector>
+#include <iostream>
+
+#include "objectrecord.h"
+#include "ymlparser.h"
+
+/* Main class (append-only journal of the object edits of a validator session) */
+class EditJournal
+{
+
+/* Public functions / variables */
+public:
+
+    /* Destructor */
+    ~EditJournal();
+
+    /* Function to get journal path of a YML file */
+    static QString journalPath(QString path);
+
+    /* Function to replay a left over journal onto objects loaded from YML, assigns objects ids, returns replayed entries */
+    int replay(QString path, QVector<ObjectRecord>* records, QVector<int>* ids);
+
+    /* Function to start a fresh journal from current objects */
+    bool begin(QString path, const QVector<int> &ids, const QVector<ObjectRecord> &records);
+
+    /* Function to continue a replayed journal from current objects (journal kept as is) */
+    bool resume(QString path, const QVector<int> &ids, const QVector<ObjectRecord> &records);
+
+    /* Function to append changes between journaled and current objects, returns written entries, -1 on write failure */
+    int append(const QVector<int> &ids, const QVector<ObjectRecord> &records);
+
+    /* Function to fold current objects into YML file and restart journal (journal kept if YML could not be written) */
+    bool compact(QString path, const QVector<int> &ids, const QVector<ObjectRecord> &records);
+
+    /* Function to close and delete journal (changes saved or discarded) */
+    void discard();
+
+/* Private functions / variables */
+private:
+
+    /* Function to append a line to journal */
+    bool writeLine(const QJsonObject &line);
+
+    /* Destination YML path */
+    QString yml_path;
+
+    /* Journal file */
+    QFile file;
+
+    /* Journaled objects by id */
+    QHash<int, ObjectRecord> state;
+};
+
+#endif // EDITJOURNAL_H
@@ -0,0 +1,181 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef ETG_KERNEL_H
+#define ETG_KERNEL_H
+
+/* Includes */
+#include <QImage>
+#include <QRect>
+#include <QRectF>
+#include <QVector>
+
+#include <inter-all.h>
+#include <gnomonic-all.h>
+
+/* Projection kernels struct */
+struct EtgKernel
+{
+    enum Type
+    {
+        /* Generic libgnomonic kernel */
+        Scalar = 0,
+
+        /* SSE4.1 kernel (4 pixels per iteration) */
+        SSE4 = 1,
+
+        /* AVX2 kernel (8 pixels per iteration) */
+        AVX2 = 2
+    };
+};
+
+/* Interpolation methods struct */
+struct EtgInterpolation
+{
+    enum Type
+    {
+        /* Bilinear (four neighbours, full quality) */
+        Bilinear = 0,
+
+        /* Nearest neighbour (interactive preview) */
+        Nearest = 1
+    };
+};
+
+/* Remap entry structure (source location of one destination pixel) */
+struct remap_entry_struct{
+
+    /* Offset, in pixels, of the top-left bilinear neighbour in source image */
+    quint32 offset;
+
+    /* Bilinear weights (0 - 256) */
+    quint16 weight_x;
+    quint16 weight_y;
+};
+
+/* Projection frame structure (per-view constants shared by all kernels) */
+struct etg_frame_struct{
+
+    /* Rectilinear to equirectangular rotation matrix */
+    double m[3][3];
+
+    /* Rectilinear pixel size (horizontal / vertical) */
+    double pixel_x;
+    double pixel_y;
+
+    /* Rectilinear image center */
+    double center_x;
+    double center_y;
+
+    /* Source (equirectangular) image dimensions */
+    int s_width;
+    int s_height;
+    int s_stride;
+};
+
+/* Function to get the kernel selected for current CPU */
+int etg_kernel_type();
+
+/* Function to compute projection frame of a gnomonic view */
+void etg_kernel_frame(etg_frame_struct* frame,
+                      const QImage* source,
+                      int width,
+                      int height,
+                      float azimuth,
+                      float elevation,
+                      float aperture);
+
+/* Function to compute remap entries of a destination row segment */
+void etg_kernel_coords(const etg_frame_struct* frame,
+                       int y,
+                       int x,
+                       int count,
+                       remap_entry_struct* entries);
+
+/* Function to interpolate destination pixels from remap entries */
+void etg_kernel_gather(const quint32* s_bits,
+                       int s_stride,
+                       const remap_entry_struct* entries,
+                       int count,
+                       quint32* line);
+
+/* Function to pick nearest destination pixels from remap entries */
+void etg_kernel_gather_nearest(const quint32* s_bits,
+                               int s_stride,
+                               const remap_entry_struct* entries,
+                               int count,
+                               quint32* line);
+
+/* Function to project an equirectangular ARGB32 image into a gnomonic RGB32 image */
+void etg_kernel_project(const QImage* source,
+                        QImage* dest,
+                        float azimuth,
+                        float elevation,
+                        float aperture,
+                        int threads,
+                        int interpolation = EtgInterpolation::Bilinear);
+
+/* Function to project only a sub-rectangle of a gnomonic view into dest (dest size is rect size) */
+void etg_kernel_project_rect(const QImage* source,
+                             QImage* dest,
+                             int width,
+                             int height,
+                             const QRect &rect,
+                             float azimuth,
+                             float elevation,
+                             float aperture,
+                             int threads);
+
+/* Function to project a sub-rectangle of a gnomonic view resampled to whole dest */
+void etg_kernel_project_scaled(const QImage* source,
+                               QImage* dest,
+                               int width,
+                               int height,
+                               const QRectF &rect,
+                               float azimuth,
+                               float elevation,
+                               float aperture,
+                               int threads);
+
+/* Function to shrink an RGB32 image by an integer factor (box filter) */
+void etg_kernel_downsample(const QImage* source,
+                           QImage* dest,
+                           int factor,
+                           int threads);
+
+#endif // ETG_KERNEL_H
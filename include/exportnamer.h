@@ -0,0 +1,75 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef EXPORTNAMER_H
+#define EXPORTNAMER_H
+
+/* Includes */
+#include <QDir>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QFileInfo>
+
+/* Main class (allocates "N.<extension>" tile names without probing the filesystem) */
+class ExportNamer
+{
+
+/* Public functions / variables */
+public:
+
+    /* Constructor */
+    ExportNamer(QString extension = "png");
+
+    /* Function to allocate next free tile path in a directory (created if missing) */
+    QString allocate(QString path);
+
+/* Private functions / variables */
+private:
+
+    /* Function to find the highest tile number already present in a directory */
+    int scanDirectory(QString path);
+
+    /* Next free tile number per directory */
+    QHash<QString, int> next_ids;
+
+    /* Tile file extension */
+    QString extension;
+};
+
+#endif // EXPORTNAMER_H
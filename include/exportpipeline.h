@@ -0,0 +1,128 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef EXPORTPIPELINE_H
+#define EXPORTPIPELINE_H
+
+/* Includes */
+#include <QThread>
+#include <QSemaphore>
+#include <QSharedPointer>
+#include <QImage>
+#include <QVector>
+#include <QString>
+#include <QFile>
+#include <QTextStream>
+#include <QRegExp>
+#include <QStringList>
+#include <iostream>
+
+#include "boundedqueue.h"
+#include "objectrecord.h"
+#include "ymlparser.h"
+#include "utils.h"
+
+/* Manifest entry structure (one panorama) */
+struct manifest_entry_struct{
+    QString image_path;
+    QString yml_path;
+};
+
+/* Decoded panorama structure (passed from decoder to exporter) */
+struct export_panorama_struct{
+    manifest_entry_struct entry;
+    QSharedPointer<QImage> image;
+    QVector<ObjectRecord> records;
+    bool valid;
+};
+
+/* Function to read a manifest of "<image path> <validated yml path>" lines */
+bool loadManifest(QString path, QVector<manifest_entry_struct>* entries);
+
+/* Panorama deleter, frees an in-flight slot once the last tile is written */
+struct PanoramaRelease
+{
+    /* In-flight panoramas slots */
+    QSemaphore* slots;
+
+    /* Constructor */
+    PanoramaRelease(QSemaphore* slots) : slots(slots) {}
+
+    /* Function called when the panorama is no longer referenced */
+    void operator()(QImage* image)
+    {
+        /* Release image */
+        delete image;
+
+        /* Give slot back to decoder */
+        this->slots->release();
+    }
+};
+
+/* Main class (decodes manifest panoramas ahead of the exporter) */
+class PanoramaDecoder : public QThread
+{
+
+/* Public functions / variables */
+public:
+
+    /* Constructor */
+    PanoramaDecoder(const QVector<manifest_entry_struct> &entries,
+                    BoundedQueue<export_panorama_struct>* queue,
+                    QSemaphore* slots);
+
+/* Protected functions / variables */
+protected:
+
+    /* Function to decode every panorama in manifest order (runs in decoder thread) */
+    void run();
+
+/* Private functions / variables */
+private:
+
+    /* Panoramas to decode */
+    QVector<manifest_entry_struct> entries;
+
+    /* Output queue */
+    BoundedQueue<export_panorama_struct>* queue;
+
+    /* In-flight panoramas slots */
+    QSemaphore* slots;
+};
+
+#endif // EXPORTPIPELINE_H
@@ -0,0 +1,101 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef EXPORTTASK_H
+#define EXPORTTASK_H
+
+/* Includes */
+#include <QRunnable>
+#include <QImage>
+#include <QRect>
+#include <QSize>
+#include <QString>
+#include <QSharedPointer>
+
+#include "objectrecord.h"
+#include "tileencoder.h"
+
+/* Main class */
+class ExportTask : public QRunnable
+{
+
+/* Public functions / variables */
+public:
+
+    /* Constructor */
+    ExportTask(QSharedPointer<QImage> source,
+               const ObjectRecord &record,
+               QRect selection,
+               float zoom_level,
+               QSize size,
+               QString destination,
+               int threads,
+               TileEncoder* encoder);
+
+    /* Function to warp and crop the tile, then hand it to encoder (runs in pool thread) */
+    void run();
+
+/* Private functions / variables */
+private:
+
+    /* Source panorama (shared, read-only, released with the last tile) */
+    QSharedPointer<QImage> source;
+
+    /* Exported object */
+    ObjectRecord record;
+
+    /* Tile selection in object projection */
+    QRect selection;
+
+    /* Export zoom level */
+    float zoom_level;
+
+    /* Tile size (invalid for selection size) */
+    QSize size;
+
+    /* Tile output path */
+    QString destination;
+
+    /* Encoder stage */
+    TileEncoder* encoder;
+
+    /* Number of threads used by warp */
+    int threads;
+};
+
+#endif // EXPORTTASK_H
@@ -0,0 +1,75 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef FRAMEITEM_H
+#define FRAMEITEM_H
+
+/* Includes */
+#include <QGraphicsItem>
+#include <QPainter>
+#include <QImage>
+
+/* Main class (scene item painting rendered frames straight from their buffer) */
+class FrameItem : public QGraphicsItem
+{
+
+/* Public functions / variables */
+public:
+
+    /* Constructor */
+    FrameItem(QGraphicsItem* parent = 0);
+
+    /* Function to replace shown frame (no copy, frame buffer is shared) */
+    void setFrame(const QImage &frame);
+
+    /* Function to get item bounding rect */
+    QRectF boundingRect() const;
+
+    /* Function to paint item */
+    void paint(QPainter* painter,
+               const QStyleOptionGraphicsItem* option,
+               QWidget* widget);
+
+/* Private functions / variables */
+private:
+
+    /* Shown frame */
+    QImage frame;
+};
+
+#endif // FRAMEITEM_H
@@ -0,0 +1,87 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef IMAGEPYRAMID_H
+#define IMAGEPYRAMID_H
+
+/* Includes */
+#include <cmath>
+#include <QImage>
+#include <QVector>
+
+#include "etg_kernel.h"
+
+/* Main class (2x downsampled levels of an equirectangular image) */
+class ImagePyramid
+{
+
+/* Public functions / variables */
+public:
+
+    /* Constructor */
+    ImagePyramid();
+
+    /* Destructor */
+    ~ImagePyramid();
+
+    /* Function to build levels of source image (source is not owned) */
+    void build(const QImage* source, int threads);
+
+    /* Function to release all levels */
+    void clear();
+
+    /* Function to get number of levels (source included) */
+    int levels() const;
+
+    /* Function to get image of a level (level 0 is source) */
+    const QImage* level(int index) const;
+
+    /* Function to select level whose texel density matches a destination frame */
+    int select(int width, float aperture) const;
+
+/* Private functions / variables */
+private:
+
+    /* Source image */
+    const QImage* source;
+
+    /* Downsampled levels (owned, level 1 first) */
+    QVector<QImage*> images;
+};
+
+#endif // IMAGEPYRAMID_H
@@ -44,21 +44,7 @@
 #include "mainwindow.h"
 #include "batchview.h"
 #include "ymlparser.h"
-
-/* Application working modes struct */
-struct ApplicationMode
-{
-    enum Type
-    {
-        /* Start the standard validator */
-        Validator = 0,
-
-        /* Start the tiles exporter */
-        Exporter = 1,
-
-        /* Start the YML converter */
-        YMLConverter = 2
-    };
-};
+#include "batchmodes.h"
+#include "batchoptions.h"
 
 #endif // MAIN_H
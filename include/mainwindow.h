@@ -45,10 +45,12 @@
 #include <QThread>
 #include <QLabel>
 #include <QPalette>
+#include <QTimer>
 #include <iostream>
 
 #include "panoramaviewer.h"
 #include "batchview.h"
+#include "editjournal.h"
 
 /* Default class container */
 namespace Ui {
@@ -97,8 +99,12 @@ private slots:
     /* Local UI actions */
     void refreshLabels();
     void updateScaleSlider(int value);
+    void updateRenderTime(float time, float scale);
     void onESC();
 
+    /* Journal actions */
+    void journalChanges();
+
 /* Private functions / variables */
 private:
 
@@ -112,6 +118,19 @@ private:
     QString good_color;
     QString warn_color;
 
+    /* Function to collect objects records and ids */
+    void collectRecords(QVector<int>* ids, QVector<ObjectRecord>* records);
+
+    /* Function to stop journaling and delete journal */
+    void closeJournal();
+
+    /* Edits journal (enabled when work is saved to destination YML) */
+    EditJournal journal;
+    bool journal_enabled;
+
+    /* Journal timer */
+    QTimer* journal_timer;
+
 /* Protected elements */
 protected:
 
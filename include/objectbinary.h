@@ -0,0 +1,174 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef OBJECTBINARY_H
+#define OBJECTBINARY_H
+
+/* Includes */
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDateTime>
+#include <QHash>
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <iostream>
+#include <cstring>
+
+#include "objectrecord.h"
+
+/* Binary objects file magic / version */
+#define OBJECT_BINARY_MAGIC "YFDB"
+#define OBJECT_BINARY_VERSION 4
+
+/* Byte order marker (files are stored in host order) */
+#define OBJECT_BINARY_BYTE_ORDER 0x01020304
+
+/* Binary objects file header structure */
+struct object_binary_header_struct{
+
+    /* File identification */
+    char magic[4];
+    quint32 version;
+    quint32 byte_order;
+    quint32 record_size;
+
+    /* Number of records (childrens included) */
+    quint32 count;
+
+    /* Source image path of first object (string table offset) */
+    quint32 source_image;
+
+    /* Records / string table location */
+    quint64 records_offset;
+    quint64 strings_offset;
+    quint64 strings_size;
+
+    /* Size / modification time (ms since epoch) of the YML written along (-1 if none) */
+    qint64 yml_size;
+    qint64 yml_modified;
+};
+
+/* Binary object record structure (fixed size, childrens follow their parent depth first) */
+struct object_binary_record_struct{
+
+    /* Object infos */
+    qint32 type;
+    qint32 sub_type;
+    qint32 automatic_state;
+    qint32 manual_state;
+    qint32 blurred;
+    qint32 automatic_status;
+    qint32 manual_status;
+
+    /* Number of direct childrens */
+    quint32 childrens;
+
+    /* Projection parameters */
+    float azimuth;
+    float elevation;
+    float aperture;
+    float width;
+    float height;
+
+    /* Source image path (string table offset) */
+    quint32 source_image;
+
+    /* Projection points (x, y) */
+    double points[8];
+};
+
+/* Main class (memory mapped, read-only view of a binary objects file) */
+class ObjectBinaryFile
+{
+
+/* Public functions / variables */
+public:
+
+    /* Constructor */
+    ObjectBinaryFile();
+
+    /* Destructor */
+    ~ObjectBinaryFile();
+
+    /* Function to map a binary objects file, false if missing or invalid */
+    bool open(QString path);
+
+    /* Function to unmap file */
+    void close();
+
+    /* Function to get number of records (childrens included) */
+    int count() const;
+
+    /* Function to access a record in place */
+    const object_binary_record_struct* record(int index) const;
+
+    /* Function to get a string of the string table */
+    QString string(quint32 offset) const;
+
+    /* Function to get source image path */
+    QString sourceImage() const;
+
+    /* Function to convert mapped records into ObjectRecord list */
+    QVector<ObjectRecord> objects() const;
+
+    /* Function to check if file was written along given YML, as the YML is now */
+    bool matches(QString yml_path) const;
+
+    /* Function to write ObjectRecord list as binary objects file (yml_path: YML holding the same objects, if any) */
+    static bool write(const QVector<ObjectRecord> &objects, QString path, QString yml_path = QString());
+
+/* Private functions / variables */
+private:
+
+    /* Function to convert a record and its childrens, returns index of next sibling */
+    int readObject(int index, QHash<quint32, QString>* strings, ObjectRecord* object) const;
+
+    /* Mapped file */
+    QFile file;
+
+    /* Mapped data */
+    const uchar* data;
+    qint64 size;
+
+    /* Mapped header */
+    const object_binary_header_struct* header;
+};
+
+#endif // OBJECTBINARY_H
@@ -111,12 +111,12 @@ public:
     void setItemAutomaticState(int state);
 
     /* Automatic status setter/getter */
-    void setAutomaticStatus(QString value);
-    QString getAutomaticStatus();
+    void setAutomaticStatus(int value);
+    int getAutomaticStatus();
 
     /* Manual status setter/getter */
-    void setManualStatus(QString value);
-    QString getManualStatus();
+    void setManualStatus(int value);
+    int getManualStatus();
 
     /* Function to determine if object is valid */
     bool isValid();
@@ -164,10 +164,10 @@ private:
     QImage image;
 
     /* Manual status container */
-    QString manualStatus;
+    int manualStatus;
 
     /* Automatic status container */
-    QString autoStatus;
+    int autoStatus;
 
     /* Parent rect copy container */
     ObjectRect* parent_rect_copy;
@@ -0,0 +1,225 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef OBJECTRECORD_H
+#define OBJECTRECORD_H
+
+/* Includes */
+#include <QPointF>
+#include <QSizeF>
+#include <QString>
+#include <QVector>
+
+#include "etg_point.h"
+#include "g2g_point.h"
+#include "projectioncontext.h"
+
+/* Automatic states struct */
+struct ObjectAutomaticState
+{
+    enum Type
+    {
+        /* Object is valid */
+        Valid = 1,
+
+        /* Object is invalid */
+        Invalid = 2,
+
+        /* Object has been manualy added */
+        Manual = 3
+    };
+};
+
+/* Manual states struct */
+struct ObjectManualState
+{
+    enum Type
+    {
+        /* Not validated */
+        None = 0,
+
+        /* Object is valid */
+        Valid = 1,
+
+        /* Object is invalid */
+        Invalid = 2,
+
+        /* Object is to be blured */
+        ToBlur = 3
+    };
+};
+
+/* Automatic statuses struct (pre-filter result) */
+struct ObjectAutomaticStatus
+{
+    enum Type
+    {
+        /* Not pre-filtered (manual object) */
+        None = 0,
+
+        /* Object passed pre-filters */
+        Valid = 1,
+
+        /* Object filtered by ratio */
+        Ratio = 2,
+
+        /* Object filtered by size */
+        Size = 3,
+
+        /* Object filtered by ratio and size */
+        RatioSize = 4,
+
+        /* Object filtered by missing detector option */
+        MissingOption = 5
+    };
+};
+
+/* Manual statuses struct */
+struct ObjectManualStatus
+{
+    enum Type
+    {
+        /* Not validated */
+        None = 0,
+
+        /* Object is valid */
+        Valid = 1,
+
+        /* Object is invalid */
+        Invalid = 2
+    };
+};
+
+/* Object types struct */
+struct ObjectType
+{
+    enum Type
+    {
+        None = 0, Face = 1, NumberPlate = 2, ToBlur = 3
+    };
+};
+
+/* Object sub-types struct */
+struct ObjectSubType
+{
+    enum Type
+    {
+        None = 0, Front = 1, Profile = 2, Back = 3, Top = 4, Eyes = 5
+    };
+};
+
+/* Object record (plain value describing one object, no graphics) */
+struct ObjectRecord
+{
+    /* Constructor */
+    ObjectRecord();
+
+    /* Object infos */
+    int type;
+    int sub_type;
+    int automatic_state;
+    int manual_state;
+    bool blurred;
+    int automatic_status;
+    int manual_status;
+
+    /* Projection parameters */
+    float azimuth;
+    float elevation;
+    float aperture;
+    float width;
+    float height;
+
+    /* Projection points */
+    QPointF points[4];
+
+    /* Source image path */
+    QString source_image;
+
+    /* Childrens container */
+    QVector<ObjectRecord> childrens;
+
+    /* Function to set projection points, missing points (zero coordinate) are computed from the others */
+    void setPoints(QPointF p1, QPointF p2, QPointF p3, QPointF p4);
+
+    /* Function to get object class name (as written in YML) */
+    QString className() const;
+
+    /* Function to get object sub-class name (as written in YML) */
+    QString subClassName() const;
+
+    /* Function to get automatic status name (as written in YML) */
+    QString automaticStatusName() const;
+
+    /* Function to get manual status name (as written in YML) */
+    QString manualStatusName() const;
+
+    /* Function to parse automatic status name (case insensitive), unknown names give None */
+    static int parseAutomaticStatus(QString name);
+
+    /* Function to parse manual status name (case insensitive), unknown names give Invalid */
+    static int parseManualStatus(QString name);
+
+    /* Function to get object size in its projection */
+    QSizeF getSize() const;
+
+    /* Comparison operators (all fields, childrens included) */
+    bool operator==(const ObjectRecord &other) const;
+    bool operator!=(const ObjectRecord &other) const;
+
+    /* Function to map projection points to specified projection paramaters */
+    void mapTo(float width,
+               float height,
+               float azimuth,
+               float elevation,
+               float aperture,
+               QPointF* mapped) const;
+
+    /* Function to convert spherical coordinates to gnomonic projection parameters / points */
+    void mapFromSpherical(float source_width,
+                          float source_height,
+                          float dest_width,
+                          float dest_height,
+                          float dest_zoom_min,
+                          float dest_zoom_max);
+
+    /* Function to complete missing points (zero coordinate) of a rectangle */
+    static void completePoints(QPointF p1, QPointF p2, QPointF p3, QPointF p4, QPointF* points);
+};
+
+#endif // OBJECTRECORD_H
@@ -43,61 +43,8 @@
 #include <QGraphicsPolygonItem>
 #include <QPen>
 
-#include "etg_point.h"
-#include "g2g_point.h"
-
-/* Automatic states struct */
-struct ObjectAutomaticState
-{
-    enum Type
-    {
-        /* Object is valid */
-        Valid = 1,
-
-        /* Object is invalid */
-        Invalid = 2,
-
-        /* Object has been manualy added */
-        Manual = 3
-    };
-};
-
-/* Manual states struct */
-struct ObjectManualState
-{
-    enum Type
-    {
-        /* Not validated */
-        None = 0,
-
-        /* Object is valid */
-        Valid = 1,
-
-        /* Object is invalid */
-        Invalid = 2,
-
-        /* Object is to be blured */
-        ToBlur = 3
-    };
-};
-
-/* Object types struct */
-struct ObjectType
-{
-    enum Type
-    {
-        None = 0, Face = 1, NumberPlate = 2, ToBlur = 3
-    };
-};
-
-/* Object sub-types struct */
-struct ObjectSubType
-{
-    enum Type
-    {
-        None = 0, Front = 1, Profile = 2, Back = 3, Top = 4, Eyes = 5
-    };
-};
+#include "objectrecord.h"
+#include "sphereindex.h"
 
 /* Main class */
 class ObjectRect : public QGraphicsPolygonItem
@@ -109,8 +56,11 @@ public:
     /* Constructor */
     ObjectRect();
 
-    /* Childrens container */
-    QList<ObjectRect*> childrens;
+    /* Constructor (view over a record) */
+    ObjectRect(const ObjectRecord &record);
+
+    /* Function to get object record */
+    ObjectRecord toRecord();
 
     /* Points setters */
     void setPoint1(QPointF point);
@@ -214,6 +164,21 @@ public:
                float elevation,
                float aperture);
 
+    /* Function to map object to a precomputed view frame, returns visibility */
+    bool mapTo(const ProjectionContext &view);
+
+    /* Function to update object visibility in a precomputed view frame */
+    bool updateInView(const ProjectionContext &view);
+
+    /* Function to get object visibility computed by last mapping */
+    bool isInView();
+
+    /* Function to get spherical cap enclosing object (spatial indexing) */
+    sphere_cap_struct getSphereCap();
+
+    /* Function to get objects geometry revision (changes with any projection parameters/points) */
+    static int geometryRevision();
+
     /* Function to convert spherical coordinates to gnomonic coordinates */
     void mapFromSpherical(float source_width,
                           float source_height,
@@ -233,12 +198,12 @@ public:
     bool isBlurred();
 
     /* Manual status setter/getter */
-    void setManualStatus(QString value);
-    QString getManualStatus();
+    void setManualStatus(int value);
+    int getManualStatus();
 
     /* Automatic status setter/getter */
-    void setAutomaticStatus(QString value);
-    QString getAutomaticStatus();
+    void setAutomaticStatus(int value);
+    int getAutomaticStatus();
 
     /* Resize setter/getter */
     void setResizeEnabled(bool value);
@@ -250,13 +215,6 @@ private:
     /* Id container */
     int id;
 
-    /* State container */
-    int manual_state;
-
-    /* Type containers */
-    int automatic_state;
-    int type;
-
     /* Resize enabled state variable */
     bool resizeEnabled;
 
@@ -282,26 +240,23 @@ private:
     /* Brush container */
     QBrush* brush;
 
-    /* Projection parameters structure */
-    struct projection_parameters_struct{
-        float azimuth;
-        float elevation;
-        float aperture;
-        float width;
-        float height;
-        QVector<QPointF> points;
-        QString source_image;
-    } projection_parameters;
-
-    /* Object infos structure */
-    struct info_struct{
-        int type;
-        int sub_type;
-        bool blurred;
-        bool validated;
-        QString manual_status;
-        QString automatic_status;
-    } info;
+    /* Object record (infos, projection parameters and points) */
+    ObjectRecord record;
+
+    /* Cached projection context of object (rebuilt when projection parameters change) */
+    ProjectionContext frame;
+
+    /* Visibility computed by last mapping */
+    bool in_view;
+
+    /* Objects geometry revision counter */
+    static int geometry_revision;
+
+    /* Function to rebuild object projection context if projection parameters changed */
+    void updateFrame();
+
+    /* Function to project object points into a precomputed view frame, returns visibility */
+    bool project(const ProjectionContext &view, QPointF* mapped);
 
     /* Function to render object */
     void render();
@@ -50,12 +50,18 @@
 #include <QGraphicsProxyWidget>
 #include <QWheelEvent>
 #include <QMouseEvent>
+#include <QSet>
+#include <QTimer>
 
 #include <inter-all.h>
 #include <gnomonic-all.h>
 
 #include "g2g_point.h"
 #include "objectrect.h"
+#include "frameitem.h"
+#include "sphereindex.h"
+#include "renderworker.h"
+#include "imagepyramid.h"
 #include "utils.h"
 
 /* Visibility groups struct */
@@ -78,6 +84,9 @@ public:
     /* Constructor */
     explicit PanoramaViewer(QWidget *parent = 0, bool connectSlots = true);
 
+    /* Destructor */
+    ~PanoramaViewer();
+
     /* Variable to store all image informations */
     image_info_struct image_info;
 
@@ -142,6 +151,9 @@ public:
     /* Function to render panorama and all objects */
     void render();
 
+    /* Function to request panorama rendering in worker thread (objects follow when frame lands) */
+    void requestRender(bool interactive = false);
+
     /* Function to crop an object and return its tile */
     QImage cropObject(ObjectRect* rect);
 
@@ -181,6 +193,14 @@ public slots:
     /* Slot for main window scale slider update */
     void updateScaleSlider_slot(int value);
 
+    /* Slot for full quality rendering once input is idle */
+    void idleRender_slot();
+
+    /* Slot for frames rendered by worker thread */
+    void frameReady_slot(QImage frame,
+                         render_request_struct request,
+                         float render_time);
+
 /* Private functions / variables */
 private:
 
@@ -196,11 +216,35 @@ private:
     /* Main PanoramaViewer scene */
     QGraphicsScene* scene;
 
-    /* Destination image to be shown */
+    /* Destination image to be shown (shares render target of worker) */
     QImage dest_image;
 
-    /* Destination image to be shown in pixmap format */
-    QPixmap dest_image_map;
+    /* Panorama frames renderer (owns remap tables cache) */
+    RenderWorker* render_worker;
+
+    /* Downsampled levels of input image (wide aperture frames) */
+    ImagePyramid* image_pyramid;
+
+    /* Timer for full quality pass after interaction (single shot) */
+    QTimer* idle_timer;
+
+    /* Resolution of interactive frames (relative to scale factor, adapted to render time) */
+    float interactive_scale;
+
+    /* Serial of last requested frame / of shown frame */
+    int render_serial;
+    int frame_serial;
+
+    /* Projection parameters of shown frame */
+    float frame_azimuth;
+    float frame_elevation;
+    float frame_aperture;
+
+    /* Frame landed during object edition (shown on mouse release) */
+    QImage held_frame;
+    render_request_struct held_request;
+    float held_render_time;
+    bool frame_held;
 
     /* Main image path */
     QString image_path;
@@ -224,9 +268,6 @@ private:
     bool createEnabled;
     bool editEnabled;
 
-    /* Main pixmap initialized value storage */
-    bool pixmap_initialized;
-
     /* Variables to store previous sizes on window resize */
     int previous_height;
     int previous_width;
@@ -237,8 +278,8 @@ private:
     /* Current visibility group */
     int vis_group;
 
-    /* Last rendered pixmap */
-    QGraphicsPixmapItem* last_pixmap;
+    /* Scene item painting shown frame */
+    FrameItem* frame_item;
 
     /* Main sight container */
     QGraphicsRectItem* sight;
@@ -306,8 +347,56 @@ private:
                          QPointF p3,
                          QPointF p4);
 
-    /* Function to apply visibility groups */
-    void applyVisGroup();
+    /* Function to apply visibility groups (mapped: objects visibility already computed by render) */
+    void applyVisGroup(bool mapped = false);
+
+    /* Function to get size of full quality frames (size recorded with objects) */
+    QSize fullFrameSize();
+
+    /* Function to compute current view projection context (shared by all objects mappings) */
+    ProjectionContext viewFrame();
+
+    /* Function to build a frame request for given projection parameters */
+    render_request_struct frameRequest(float azimuth,
+                                       float elevation,
+                                       float zoom,
+                                       bool interactive = false);
+
+    /* Function to show a rendered frame in scene */
+    void showFrame(const QImage &frame,
+                   const render_request_struct &request,
+                   float render_time);
+
+    /* Function to map and show objects over shown frame */
+    void renderObjects();
+
+    /* Objects spatial index (directions on sphere) */
+    SphereIndex object_index;
+
+    /* Objects referenced by spatial index entries */
+    QVector<ObjectRect*> indexed_objects;
+
+    /* Objects count / geometry revision of spatial index */
+    int indexed_count;
+    int indexed_revision;
+
+    /* Spatial index rebuilt since last visibility pass */
+    bool index_rebuilt;
+
+    /* Objects near current view (last index query) */
+    QVector<ObjectRect*> candidates;
+
+    /* Objects shown by last visibility pass */
+    QSet<ObjectRect*> shown_objects;
+
+    /* Function to rebuild spatial index if objects changed */
+    void updateIndex();
+
+    /* Function to query objects near given view from spatial index */
+    void queryCandidates(const ProjectionContext &view);
+
+    /* Function to check if an object belongs to current visibility group */
+    bool isInVisGroup(ObjectRect* rect);
 
 /* Signals */
 signals:
@@ -318,6 +407,9 @@ signals:
     /* Function to update main window scale slider */
     void updateScaleSlider(int value);
 
+    /* Function to update main window render time label */
+    void updateRenderTime(float time, float scale);
+
 /* Protected functions / variables */
 protected:
 
@@ -0,0 +1,110 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef PROJECTIONCONTEXT_H
+#define PROJECTIONCONTEXT_H
+
+/* Includes */
+#include <cmath>
+#include <cstddef>
+
+#include <inter-all.h>
+#include <gnomonic-all.h>
+
+/* Main class (precomputed state of a gnomonic view, reentrant) */
+class ProjectionContext
+{
+
+/* Public functions / variables */
+public:
+
+    /* Constructor (invalid context, matches no parameters) */
+    ProjectionContext();
+
+    /* Constructor (rectilinear view of given size and gnomonic projection parameters) */
+    ProjectionContext(double width, double height, double azimuth, double elevation, double aperture);
+
+    /* Function to check if context was computed with given parameters */
+    bool matches(double width, double height, double azimuth, double elevation, double aperture) const;
+
+    /* Function to map a point of this view into another view, returns first order visibility */
+    bool mapTo(const ProjectionContext &dest, double x, double y, double* dest_x, double* dest_y) const;
+
+    /* Function to map points of this view into another view, returns number of visible points */
+    int mapTo(const ProjectionContext &dest, int count, const double* x, const double* y, double* dest_x, double* dest_y) const;
+
+    /* Function to project an equirectangular point into this view, returns first order visibility */
+    bool fromEquirectangular(double e_width, double e_height, double e_x, double e_y, double* x, double* y) const;
+
+    /* Function to project equirectangular points into this view, returns number of visible points */
+    int fromEquirectangular(double e_width, double e_height, int count, const double* e_x, const double* e_y, double* x, double* y) const;
+
+    /* Function to compute the unit direction on sphere of a point of this view */
+    void toSphere(double x, double y, double* direction) const;
+
+    /* Projection parameters getters */
+    double width() const;
+    double height() const;
+    double azimuth() const;
+    double elevation() const;
+    double aperture() const;
+
+    /* Pixel size getter */
+    double pixel() const;
+
+/* Private functions / variables */
+private:
+
+    /* View to sphere rotation matrix */
+    double r2e[3][3];
+
+    /* Sphere to view rotation matrix */
+    double e2r[3][3];
+
+    /* Pixel size */
+    double pixel_size;
+
+    /* Projection parameters */
+    double view_width;
+    double view_height;
+    double view_azimuth;
+    double view_elevation;
+    double view_aperture;
+};
+
+#endif // PROJECTIONCONTEXT_H
@@ -0,0 +1,135 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef REMAPCACHE_H
+#define REMAPCACHE_H
+
+/* Includes */
+#include <QImage>
+#include <QCache>
+#include <QVector>
+#include <QHash>
+
+#include "etg_kernel.h"
+
+/* Remap table key structure */
+struct remap_key_struct{
+    int source_width;
+    int source_height;
+    int width;
+    int height;
+    float azimuth;
+    float elevation;
+    float aperture;
+};
+
+/* Remap table key comparison operator */
+bool operator==(const remap_key_struct &a, const remap_key_struct &b);
+
+/* Remap table key hash function */
+uint qHash(const remap_key_struct &key, uint seed = 0);
+
+/* Remap table class */
+class RemapTable
+{
+
+/* Public functions / variables */
+public:
+
+    /* Constructor */
+    RemapTable(int width, int height);
+
+    /* Function to compute source coordinates and weights of every destination pixel */
+    void build(const QImage* source,
+               float azimuth,
+               float elevation,
+               float aperture,
+               int threads);
+
+    /* Function to render destination image using precomputed table */
+    void gather(const QImage* source,
+                QImage* dest,
+                int threads,
+                int interpolation = EtgInterpolation::Bilinear) const;
+
+    /* Function to get table memory cost in kilobytes */
+    int cost() const;
+
+/* Private functions / variables */
+private:
+
+    /* Destination image dimensions */
+    int width;
+    int height;
+
+    /* Table entries (one per destination pixel) */
+    QVector<remap_entry_struct> entries;
+};
+
+/* Main class */
+class RemapCache
+{
+
+/* Public functions / variables */
+public:
+
+    /* Constructor */
+    RemapCache(int max_size = 256);
+
+    /* Function to drop all cached tables */
+    void clear();
+
+    /* Function to project gnomonic image using cached remap tables (libgnomonic without tables on CPUs lacking SIMD kernels) */
+    /* Uncached frames reuse an existing table but never build one */
+    void project(const QImage* source,
+                 QImage* dest,
+                 float azimuth,
+                 float elevation,
+                 float aperture,
+                 int threads,
+                 int interpolation = EtgInterpolation::Bilinear,
+                 bool cache = true);
+
+/* Private functions / variables */
+private:
+
+    /* Cached tables (cost in kilobytes) */
+    QCache<remap_key_struct, RemapTable> tables;
+};
+
+#endif // REMAPCACHE_H
@@ -0,0 +1,142 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef RENDERWORKER_H
+#define RENDERWORKER_H
+
+/* Includes */
+#include <QThread>
+#include <QImage>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QMetaType>
+#include <QAtomicInt>
+#include <QVector>
+
+#include "remapcache.h"
+
+/* Frame render request structure */
+struct render_request_struct{
+    int serial;
+    const QImage* source;
+    int width;
+    int height;
+    float azimuth;
+    float elevation;
+    float aperture;
+    int threads;
+    int interpolation;
+    bool cache;
+};
+
+/* Render request type (queued signals arguments) */
+Q_DECLARE_METATYPE(render_request_struct)
+
+/* Render target structure (reusable frame memory, freed by its last user) */
+struct render_target_struct{
+    uchar* data;
+    int capacity;
+    QAtomicInt users;
+};
+
+/* Main class (panorama frames renderer, latest request wins) */
+class RenderWorker : public QThread
+{
+    Q_OBJECT
+
+/* Public functions / variables */
+public:
+
+    /* Constructor */
+    explicit RenderWorker(QObject* parent = 0);
+
+    /* Destructor */
+    ~RenderWorker();
+
+    /* Function to request a frame in worker thread (replaces any pending request) */
+    void request(const render_request_struct &request);
+
+    /* Function to render a frame in calling thread (drops pending request), render time is in ms */
+    QImage renderNow(const render_request_struct &request,
+                     float* render_time = NULL);
+
+    /* Function to drop pending request and cached tables (waits for frame in progress) */
+    void clear();
+
+/* Signals */
+signals:
+
+    /* Signal emitted in worker thread when a requested frame is rendered (render time in ms) */
+    void frameReady(QImage frame,
+                    render_request_struct request,
+                    float render_time);
+
+/* Protected functions / variables */
+protected:
+
+    /* Function to render requested frames (runs in worker thread) */
+    void run();
+
+/* Private functions / variables */
+private:
+
+    /* Pending request (guarded by request mutex) */
+    render_request_struct next;
+    bool pending;
+    bool quit;
+    QMutex request_mutex;
+    QWaitCondition request_wake;
+
+    /* Remap tables cache (guarded by render mutex) */
+    RemapCache remap_cache;
+    QMutex render_mutex;
+
+    /* Reusable render targets (guarded by render mutex) */
+    QVector<render_target_struct*> targets;
+
+    /* Function to get a frame image over an unused render target (render mutex must be held) */
+    QImage target(int width, int height);
+
+    /* Function to render a frame and measure its render time (render mutex must be held) */
+    QImage renderFrame(const render_request_struct &request,
+                       float* render_time);
+};
+
+#endif // RENDERWORKER_H
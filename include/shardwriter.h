@@ -0,0 +1,109 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef SHARDWRITER_H
+#define SHARDWRITER_H
+
+/* Includes */
+#include <QFile>
+#include <QDir>
+#include <QByteArray>
+#include <QDateTime>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRect>
+#include <QString>
+#include <QStringList>
+#include <cstring>
+
+#include "objectrecord.h"
+
+/* Main class (appends exported tiles into tar shards) */
+class ShardWriter
+{
+
+/* Public functions / variables */
+public:
+
+    /* Constructor */
+    ShardWriter(QString exportPath, qint64 shard_size);
+
+    /* Destructor */
+    ~ShardWriter();
+
+    /* Function to append an encoded tile and its metadata to current shard (thread-safe) */
+    bool writeTile(const ObjectRecord &record, QRect selection, float zoom_level, const QByteArray &image, QString extension);
+
+    /* Function to terminate current shard, false if end of archive could not be written */
+    bool close();
+
+/* Private functions / variables */
+private:
+
+    /* Function to open next shard */
+    bool openShard();
+
+    /* Function to write end of archive marker and close current shard */
+    bool finishShard();
+
+    /* Function to append a file entry to current shard */
+    bool appendEntry(QString name, const QByteArray &data);
+
+    /* Shards directory */
+    QString path;
+
+    /* Shard size limit (bytes) */
+    qint64 shard_size;
+
+    /* Current shard file */
+    QFile shard;
+
+    /* Current shard index */
+    int shard_index;
+
+    /* Entries in current shard */
+    int tile_index;
+
+    /* Serialize writers */
+    QMutex mutex;
+};
+
+#endif // SHARDWRITER_H
@@ -0,0 +1,110 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef SPHEREINDEX_H
+#define SPHEREINDEX_H
+
+/* Includes */
+#include <cmath>
+#include <algorithm>
+#include <QVector>
+
+#include "projectioncontext.h"
+
+/* Spherical cap structure (unit direction of cap center and angular radius) */
+struct sphere_cap_struct{
+    double direction[3];
+    double radius;
+};
+
+/* Main class (azimuth/elevation bucket grid of spherical caps, single-threaded: queries share dedup marks) */
+class SphereIndex
+{
+
+/* Public functions / variables */
+public:
+
+    /* Constructor */
+    SphereIndex(int azimuth_cells = 64, int elevation_cells = 32);
+
+    /* Function to compute the cap enclosing points of a view */
+    static sphere_cap_struct cap(const ProjectionContext &frame, int count, const double* x, const double* y);
+
+    /* Function to compute the cap enclosing a whole view */
+    static sphere_cap_struct cap(const ProjectionContext &frame);
+
+    /* Function to check if two caps intersect */
+    static bool intersects(const sphere_cap_struct &a, const sphere_cap_struct &b);
+
+    /* Function to remove all items */
+    void clear();
+
+    /* Function to insert an item with its cap */
+    void insert(int item, const sphere_cap_struct &cap);
+
+    /* Function to query items whose caps intersect given cap (updates query marks, not reentrant) */
+    void query(const sphere_cap_struct &cap, QVector<int>* items) const;
+
+    /* Function to get number of items */
+    int count() const;
+
+/* Private functions / variables */
+private:
+
+    /* Grid dimensions */
+    int azimuth_cells;
+    int elevation_cells;
+
+    /* Grid cells (items indexes) */
+    QVector< QVector<int> > cells;
+
+    /* Items caps */
+    QVector<sphere_cap_struct> caps;
+
+    /* Items identifiers */
+    QVector<int> items;
+
+    /* Query marks (avoid duplicates of items spanning several cells, written by const queries) */
+    mutable QVector<int> marks;
+    mutable int mark;
+
+    /* Function to compute cells covered by a cap */
+    void cellsOf(const sphere_cap_struct &cap, QVector<int>* covered) const;
+};
+
+#endif // SPHEREINDEX_H
@@ -0,0 +1,146 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef TILEENCODER_H
+#define TILEENCODER_H
+
+/* Includes */
+#include <QThread>
+#include <QImage>
+#include <QImageWriter>
+#include <QBuffer>
+#include <QFile>
+#include <QByteArray>
+#include <QList>
+#include <QRect>
+#include <QString>
+#include <iostream>
+
+#include "boundedqueue.h"
+#include "objectrecord.h"
+#include "shardwriter.h"
+
+/* Tile waiting for encode structure */
+struct encode_job_struct{
+    QImage tile;
+    QString destination;
+    ObjectRecord record;
+    QRect selection;
+    float zoom_level;
+};
+
+/* Encoder thread class (drains the encode queue) */
+class EncoderThread : public QThread
+{
+
+/* Public functions / variables */
+public:
+
+    /* Constructor */
+    EncoderThread(BoundedQueue<encode_job_struct>* queue,
+                  QString format,
+                  int quality,
+                  ShardWriter* shards);
+
+    /* Function to get number of tiles that could not be encoded or written (valid once thread finished) */
+    int failures() const;
+
+/* Protected functions / variables */
+protected:
+
+    /* Function to encode and write queued tiles (runs in encoder thread) */
+    void run();
+
+/* Private functions / variables */
+private:
+
+    /* Input queue */
+    BoundedQueue<encode_job_struct>* queue;
+
+    /* Qt image format name */
+    QString format;
+
+    /* Codec quality (-1 for codec default) */
+    int quality;
+
+    /* Shards writer (NULL when tiles are written as individual files) */
+    ShardWriter* shards;
+
+    /* Tiles that could not be encoded or written */
+    int failed;
+};
+
+/* Main class (encoder stage, warp threads only hand tiles over) */
+class TileEncoder
+{
+
+/* Public functions / variables */
+public:
+
+    /* Constructor */
+    TileEncoder(QString format,
+                int quality,
+                int threads,
+                ShardWriter* shards = NULL);
+
+    /* Destructor */
+    ~TileEncoder();
+
+    /* Function to queue a tile for encoding (blocks only while queue is full) */
+    void push(const encode_job_struct &job);
+
+    /* Function to wait until every queued tile is written, returns number of tiles that could not be encoded or written */
+    int finish();
+
+    /* Function to get tile file extension of an export format */
+    static QString extension(QString format);
+
+    /* Function to check if an export format is available */
+    static bool isSupported(QString format);
+
+/* Private functions / variables */
+private:
+
+    /* Tiles waiting for encode */
+    BoundedQueue<encode_job_struct>* queue;
+
+    /* Encoder threads */
+    QList<EncoderThread*> workers;
+};
+
+#endif // TILEENCODER_H
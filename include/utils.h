@@ -42,12 +42,15 @@
 /* Includes */
 #include <QImage>
 #include <QThread>
+#include <QImageReader>
 
 #include <opencv/cv.h>
 #include <opencv/highgui.h>
 #include <inter-all.h>
 #include <gnomonic-all.h>
-#include "objectrect.h"
+#include "objectrecord.h"
+#include "etg_kernel.h"
+#include "bgr_swizzle.h"
 
 /* Image info structure */
 struct image_info_struct{
@@ -60,8 +63,20 @@ struct image_info_struct{
 /* Function to convert an OpenCV IplImage into a QImage */
 QImage*  IplImage2QImage(IplImage *iplImg);
 
+/* Function to load a panorama into an ARGB32 (or RGB32) image */
+bool loadPanorama(QString path, image_info_struct* image_info);
+
+/* Function to compute the tile selection of an object (thread-safe) */
+QRect exportSelection(const ObjectRecord &record, float zoom_level);
+
+/* Function to project and crop an object tile, resampled to size when valid (thread-safe) */
+QImage renderTile(const QImage* source, const ObjectRecord &record, QRect selection, float zoom_level, int threads = 1, QSize size = QSize());
+
+/* Function to project, crop and save an object tile (thread-safe) */
+void exportTile(const QImage* source, const ObjectRecord &record, QRect selection, float zoom_level, QString destination, int threads = 1);
+
 /* Function to export an object to disk */
-void exportRect(ObjectRect* rect, image_info_struct image_info, QString destination, float zoom_level = 1.5);
+void exportRect(const ObjectRecord &record, image_info_struct image_info, QString destination, float zoom_level = 1.5);
 
 /* Function to clamp a specified value */
 float clamp(float x, float a, float b);
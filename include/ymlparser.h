@@ -41,9 +41,12 @@
 
 /* Includes */
 #include <opencv2/core/core.hpp>
-#include "objectrect.h"
+#include "objectrecord.h"
+#include "ymlstream.h"
+#include "objectbinary.h"
+#include <QSaveFile>
 #include <QString>
-#include <QList>
+#include <QVector>
 
 /* YML type structure */
 struct YMLType
@@ -65,20 +68,32 @@ public:
     /* Constructor */
     YMLParser();
 
-    /* Function to write ObjectRect list to YML file on disk */
-    void writeYML(QList<ObjectRect*> objects, QString path);
+    /* Function to write ObjectRecord list to YML file on disk, false if YML could not be written */
+    bool writeYML(const QVector<ObjectRecord> &objects, QString path);
 
-    /* Function load ObjectRect list from YML file on disk */
-    QList<ObjectRect*> loadYML(QString path, int ymltype = YMLType::Validator);
+    /* Function load ObjectRecord list from YML file on disk */
+    QVector<ObjectRecord> loadYML(QString path, int ymltype = YMLType::Validator);
+
+    /* Function to get binary sidecar path of a YML file */
+    static QString binaryPath(QString path);
 
 /* Private functions / variables */
 private:
 
-    /* Function to write specific ObjectRect into YML file */
-    void writeItem(cv::FileStorage &fs, ObjectRect* obj);
+    /* Function to write specific ObjectRecord into YML file */
+    void writeItem(cv::FileStorage &fs, const ObjectRecord &obj);
+
+    /* Function to read raw YML content with OpenCV storage */
+    void readDocument(QString path, yml_document_struct* document);
+
+    /* Function to read raw fields of an object from OpenCV storage */
+    yml_item_struct readItem(cv::FileNodeIterator iterator);
+
+    /* Function to build an ObjectRecord from raw YML fields */
+    ObjectRecord buildItem(const yml_item_struct &item, int ymltype = YMLType::Validator);
 
-    /* Function to read specific ObjectRect from YML file */
-    ObjectRect* readItem(cv::FileNodeIterator iterator, int ymltype = YMLType::Validator);
+    /* Single pass YML reader */
+    YMLStreamReader stream_reader;
 };
 
 #endif // YMLREADER_H
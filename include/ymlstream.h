@@ -0,0 +1,143 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+#ifndef YMLSTREAM_H
+#define YMLSTREAM_H
+
+/* Includes */
+#include <QFile>
+#include <QByteArray>
+#include <QHash>
+#include <QPointF>
+#include <QString>
+#include <QVector>
+#include <cstring>
+
+/* Raw YML object structure (fields as written, before interpretation) */
+struct yml_item_struct{
+
+    /* Constructor */
+    yml_item_struct() : azimuth(0.0), elevation(0.0), aperture(0.0), width(0.0), height(0.0) {}
+
+    /* Tags */
+    QString false_positive;
+    QString class_name;
+    QString sub_class_name;
+    QString auto_status;
+    QString manual_status;
+    QString blur_object;
+
+    /* Area points */
+    QPointF points[4];
+
+    /* Projection parameters */
+    float azimuth;
+    float elevation;
+    float aperture;
+    float width;
+    float height;
+
+    /* Childrens */
+    QVector<yml_item_struct> childrens;
+};
+
+/* Raw YML document structure */
+struct yml_document_struct{
+    QString source_image;
+    QVector<yml_item_struct> objects;
+    QVector<yml_item_struct> invalid_objects;
+};
+
+/* Main class (single pass reader for detector / validator YML files) */
+class YMLStreamReader
+{
+
+/* Public functions / variables */
+public:
+
+    /* Constructor */
+    YMLStreamReader();
+
+    /* Function to read a YML file, false if file or layout is not supported */
+    bool read(QString path, yml_document_struct* document);
+
+/* Private functions / variables */
+private:
+
+    /* Reader frame struct (block currently being filled) */
+    struct Frame
+    {
+        enum Type
+        {
+            Root = 0, Objects = 1, Object = 2, Area = 3, Params = 4, Ignore = 5
+        };
+
+        /* Indentation of the key / dash that opened the block */
+        int indent;
+
+        /* Block type */
+        int type;
+
+        /* Objects sequence (Objects) or filled object (Object, Area, Params) */
+        QVector<yml_item_struct>* objects;
+        yml_item_struct* object;
+    };
+
+    /* Function to parse one "key: value" entry in current block */
+    bool parseEntry(const char* begin, const char* end, int indent, yml_document_struct* document);
+
+    /* Function to parse a scalar value (plain, single or double quoted) */
+    QByteArray parseScalar(const char* begin, const char* end);
+
+    /* Function to parse a float value */
+    bool parseFloat(const char* begin, const char* end, float* value);
+
+    /* Function to parse a "[ x, y ]" point value */
+    bool parsePoint(const char* begin, const char* end, QPointF* point);
+
+    /* Function to get shared copy of a repeated string (class / status names) */
+    QString intern(const QByteArray &bytes);
+
+    /* Open blocks */
+    QVector<Frame> frames;
+
+    /* Interned strings */
+    QHash<QByteArray, QString> strings;
+};
+
+#endif // YMLSTREAM_H
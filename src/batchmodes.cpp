@@ -0,0 +1,518 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "batchmodes.h"
+
+/* Function to compute the export directory of an object */
+QString exportDirectory(QString exportPath, const ObjectRecord &rect)
+{
+    /* Output path container */
+    QString path;
+
+    /* Rect type switch */
+    switch(rect.type)
+    {
+
+    /* Face */
+    case ObjectType::Face:
+
+        /* Rect subtype switch */
+        switch(rect.sub_type)
+        {
+
+        /* Undefined subtype */
+        case ObjectSubType::None:
+
+            /* Append path */
+            path = (exportPath + "/Face/None/");
+            break;
+
+        /* Front */
+        case ObjectSubType::Front:
+
+            /* Append path */
+            path = (exportPath + "/Face/Front/");
+            break;
+
+        /* Profile */
+        case ObjectSubType::Profile:
+
+            /* Append path */
+            path = (exportPath + "/Face/Profile/");
+            break;
+
+        /* Back */
+        case ObjectSubType::Back:
+
+            /* Append path */
+            path = (exportPath + "/Face/Back/");
+            break;
+
+        /* Top */
+        case ObjectSubType::Top:
+
+            /* Append path */
+            path = (exportPath + "/Face/Top/");
+            break;
+
+        /* Eyes */
+        case ObjectSubType::Eyes:
+
+            /* Append path */
+            path = (exportPath + "/Face/Eyes/");
+            break;
+        }
+        break;
+
+    /* Number plate */
+    case ObjectType::NumberPlate:
+        path = (exportPath + "/NumberPlate/");
+        break;
+
+    /* "ToBlur" */
+    case ObjectType::ToBlur:
+        path = (exportPath + "/ToBlur/");
+        break;
+    }
+
+    /* If manual status is valid */
+    if( rect.manual_status == ObjectManualStatus::Valid )
+    {
+        /* Append valid path */
+        path += "Valid/";
+
+    /* If manual status is invalid */
+    } else if ( rect.manual_status == ObjectManualStatus::Invalid ){
+
+        /* Append invalid path */
+        path += "Invalid/";
+
+    /* If rect is not human validated */
+    } else {
+
+        /* If automatic status is valid */
+        if( rect.automatic_status == ObjectAutomaticStatus::Valid )
+        {
+            /* Append specifiec valid path */
+            path += "Valid_Not_Validated/";
+        } else {
+
+            /* Append specifiec valid path */
+            path += "Invalid_Not_Validated/";
+        }
+    }
+
+    /* Return result */
+    return path;
+}
+
+/* Function to queue the tiles of a panorama on the export pool */
+void queueTiles(QThreadPool* pool,
+                QSharedPointer<QImage> image,
+                const QVector<ObjectRecord> &records,
+                QString exportPath,
+                export_options_struct options,
+                int warp_threads,
+                ExportNamer* namer,
+                TileEncoder* encoder)
+{
+    /* Iterate over loaded rects */
+    foreach(const ObjectRecord &rect, records)
+    {
+        /* Compute tile selection (cheap, keeps output names in records order) */
+        QRect selection = exportSelection( rect, options.zoom );
+
+        /* Skip objects without valid selection */
+        if( selection.isEmpty() )
+            continue;
+
+        /* Allocate output path, file is written asynchronously (no path when tiles go to shards) */
+        QString outpath = namer ? namer->allocate( exportDirectory( exportPath, rect ) ) : QString();
+
+        /* Queue tile warp, encoder stage takes over */
+        pool->start( new ExportTask( image, rect, selection, options.zoom, options.size, outpath, warp_threads, encoder ) );
+    }
+}
+
+/* Function to check export options */
+bool checkExportOptions(export_options_struct options)
+{
+    /* Check export format */
+    if( !TileEncoder::isSupported( options.format ) )
+    {
+        /* Info output */
+        std::cout << "Unsupported export format: " << options.format.toStdString() << std::endl;
+
+        /* Return result */
+        return false;
+    }
+
+    /* Return result */
+    return true;
+}
+
+/* Function to export objects of a validated YML as image tiles */
+bool exportObjects(QString sourceImagePath,
+                   QString destinationYMLPath,
+                   QString exportPath,
+                   export_options_struct options)
+{
+    /* YML Parser */
+    YMLParser yml_parser;
+
+    /* Check options */
+    if( !checkExportOptions( options ) )
+        return false;
+
+    /* Export workers pool */
+    QThreadPool pool;
+    pool.setMaxThreadCount( qMax( 1, options.jobs ) );
+
+    /* Split cores between concurrent warps */
+    int warp_threads = qMax( 1, QThread::idealThreadCount() / pool.maxThreadCount() );
+
+    /* Source image infos structure */
+    image_info_struct image_info;
+
+    /* Info output */
+    std::cout << "Reading image..." << std::endl;
+
+    /* Load image directly into its final buffer */
+    if( !loadPanorama( sourceImagePath, &image_info ) )
+    {
+        /* Info output */
+        std::cout << "Unable to read image." << std::endl;
+
+        /* Return result */
+        return false;
+    }
+
+    /* Shared image, released once the last tile is written */
+    QSharedPointer<QImage> image( image_info.image );
+
+    /* Load YML */
+    QVector<ObjectRecord> loaded_rects = yml_parser.loadYML( destinationYMLPath, YMLType::Validator );
+
+    /* Info output */
+    std::cout << "Exporting " << loaded_rects.size() << " images..." << std::endl;
+
+    /* Tiles shards writer (individual files when no shard size is given) */
+    ShardWriter* shards = options.shard_size > 0 ? new ShardWriter( exportPath, options.shard_size ) : NULL;
+
+    /* Tiles encoder stage */
+    TileEncoder* encoder = new TileEncoder( options.format, options.quality, pool.maxThreadCount(), shards );
+
+    /* Tiles names allocator */
+    ExportNamer namer( TileEncoder::extension( options.format ) );
+
+    /* Queue object tiles */
+    queueTiles( &pool, image, loaded_rects, exportPath, options, warp_threads, shards ? NULL : &namer, encoder );
+
+    /* Wait until all tiles are warped */
+    pool.waitForDone();
+
+    /* Wait until all tiles are written */
+    int failed_tiles = encoder->finish();
+    delete encoder;
+
+    /* Terminate last shard */
+    if( shards && !shards->close() )
+        failed_tiles++;
+    delete shards;
+
+    /* Check written tiles */
+    if( failed_tiles > 0 )
+    {
+        /* Error output */
+        std::cerr << failed_tiles << " tiles could not be written." << std::endl;
+
+        /* Return result */
+        return false;
+    }
+
+    /* Info output */
+    std::cout << "Done" << std::endl;
+
+    /* Return result */
+    return true;
+}
+
+/* Function to export the objects of every panorama listed in a manifest */
+bool exportManifest(QString manifestPath,
+                    QString exportPath,
+                    export_options_struct options)
+{
+    /* Manifest entries */
+    QVector<manifest_entry_struct> entries;
+
+    /* Check options */
+    if( !checkExportOptions( options ) )
+        return false;
+
+    /* Read manifest */
+    if( !loadManifest( manifestPath, &entries ) )
+    {
+        /* Info output */
+        std::cout << "Unable to read manifest." << std::endl;
+
+        /* Return result */
+        return false;
+    }
+
+    /* Export workers pool */
+    QThreadPool pool;
+    pool.setMaxThreadCount( qMax( 1, options.jobs ) );
+
+    /* Split cores between concurrent warps */
+    int warp_threads = qMax( 1, QThread::idealThreadCount() / pool.maxThreadCount() );
+
+    /* Tiles shards writer (individual files when no shard size is given) */
+    ShardWriter* shards = options.shard_size > 0 ? new ShardWriter( exportPath, options.shard_size ) : NULL;
+
+    /* Tiles encoder stage */
+    TileEncoder* encoder = new TileEncoder( options.format, options.quality, pool.maxThreadCount(), shards );
+
+    /* Panoramas held in memory (decoded, queued or being exported) */
+    QSemaphore slots( qMax( 1, options.inflight ) );
+
+    /* Decoded panoramas queue */
+    BoundedQueue<export_panorama_struct> queue( qMax( 1, options.inflight ) );
+
+    /* Decode next panoramas while current one is exported */
+    PanoramaDecoder decoder( entries, &queue, &slots );
+    decoder.start();
+
+    /* Tiles names allocator (shared by all panoramas) */
+    ExportNamer namer( TileEncoder::extension( options.format ) );
+
+    /* Number of panoramas that failed */
+    int failed = 0;
+
+    /* Panorama index */
+    int index = 0;
+
+    /* Decoded panorama */
+    export_panorama_struct panorama;
+
+    /* Iterate over decoded panoramas */
+    while( queue.pop( &panorama ) )
+    {
+        /* Increment index */
+        index++;
+
+        /* Check decoding result */
+        if( !panorama.valid )
+        {
+            /* Info output */
+            std::cout << "[" << index << "/" << entries.size() << "] Unable to read image: " << panorama.entry.image_path.toStdString() << std::endl;
+
+            /* Count failure */
+            failed++;
+            continue;
+        }
+
+        /* Info output */
+        std::cout << "[" << index << "/" << entries.size() << "] Exporting " << panorama.records.size() << " images from " << panorama.entry.image_path.toStdString() << std::endl;
+
+        /* Queue object tiles */
+        queueTiles( &pool, panorama.image, panorama.records, exportPath, options, warp_threads, shards ? NULL : &namer, encoder );
+
+        /* Drop local reference, tiles keep the image alive */
+        panorama.image.clear();
+    }
+
+    /* Wait until all tiles are warped */
+    pool.waitForDone();
+
+    /* Wait until all tiles are written */
+    int failed_tiles = encoder->finish();
+    delete encoder;
+
+    /* Terminate last shard */
+    if( shards && !shards->close() )
+        failed_tiles++;
+    delete shards;
+
+    /* Wait for decoder */
+    decoder.wait();
+
+    /* Check written tiles */
+    if( failed_tiles > 0 )
+        std::cerr << failed_tiles << " tiles could not be written." << std::endl;
+
+    /* Info output */
+    std::cout << "Done" << std::endl;
+
+    /* Return result */
+    return failed == 0 && failed_tiles == 0;
+}
+
+/* Function to convert a detector YML into a validator YML */
+bool convertYML(QString sourceImagePath,
+                QString detectorYMLPath,
+                QString destinationYMLPath)
+{
+    /* YML Parser */
+    YMLParser yml_parser;
+
+    /* Source image infos structure */
+    image_info_struct image_info;
+
+    /* Info output */
+    std::cout << "Reading image..." << std::endl;
+
+    /* Load image directly into its final buffer */
+    if( !loadPanorama( sourceImagePath, &image_info ) )
+    {
+        /* Info output */
+        std::cout << "Unable to read image." << std::endl;
+
+        /* Return result */
+        return false;
+    }
+
+    /* Load rects from YML */
+    QVector<ObjectRecord> loaded_rects = yml_parser.loadYML( detectorYMLPath, YMLType::Detector );
+
+    /* Info output */
+    std::cout << "Converting points..." << std::endl;
+
+    /* Iterate over loaded rects */
+    for( int i = 0; i < loaded_rects.size(); i++ )
+    {
+        /* Convert spherical coordinates to local gnomonic */
+        loaded_rects[i].mapFromSpherical(image_info.width,
+                                         image_info.height,
+                                         1920 / 2,
+                                         1080 / 2,
+                                         20.0 * (LG_PI / 180.0),
+                                         120.0 * (LG_PI / 180.0));
+    }
+
+    /* Info output */
+    std::cout << "Writing YML." << std::endl;
+
+    /* Write converted items to YML */
+    bool written = yml_parser.writeYML( loaded_rects, destinationYMLPath );
+
+    /* Release image */
+    delete image_info.image;
+
+    /* Check write result */
+    if( !written )
+        return false;
+
+    /* Info output */
+    std::cout << "Done." << std::endl;
+
+    /* Return result */
+    return true;
+}
+
+/* Function to convert a validated YML into a binary objects file */
+bool convertYMLToBinary(QString destinationYMLPath,
+                        QString binaryPath)
+{
+    /* Check YML */
+    if( !QFile::exists( destinationYMLPath ) )
+    {
+        /* Info output */
+        std::cout << "Unable to find YML: " << destinationYMLPath.toStdString() << std::endl;
+
+        /* Return result */
+        return false;
+    }
+
+    /* Default to YML sidecar */
+    binaryPath = binaryPath.length() > 0 ? binaryPath : YMLParser::binaryPath( destinationYMLPath );
+
+    /* Load objects from YML */
+    YMLParser yml_parser;
+    QVector<ObjectRecord> loaded_rects = yml_parser.loadYML( destinationYMLPath, YMLType::Validator );
+
+    /* Info output */
+    std::cout << "Writing binary file." << std::endl;
+
+    /* Write binary file */
+    if( !ObjectBinaryFile::write( loaded_rects, binaryPath, destinationYMLPath ) )
+        return false;
+
+    /* Info output */
+    std::cout << "Done." << std::endl;
+
+    /* Return result */
+    return true;
+}
+
+/* Function to convert a binary objects file into a validated YML */
+bool convertBinaryToYML(QString binaryPath,
+                        QString destinationYMLPath)
+{
+    /* Default to YML sidecar */
+    binaryPath = binaryPath.length() > 0 ? binaryPath : YMLParser::binaryPath( destinationYMLPath );
+
+    /* Map binary file */
+    ObjectBinaryFile binary;
+    if( !binary.open( binaryPath ) )
+    {
+        /* Info output */
+        std::cout << "Unable to read binary file: " << binaryPath.toStdString() << std::endl;
+
+        /* Return result */
+        return false;
+    }
+
+    /* Convert records, unmap before the sidecar gets rewritten */
+    QVector<ObjectRecord> loaded_rects = binary.objects();
+    binary.close();
+
+    /* Info output */
+    std::cout << "Writing YML." << std::endl;
+
+    /* Write objects to YML */
+    YMLParser yml_parser;
+    if( !yml_parser.writeYML( loaded_rects, destinationYMLPath ) )
+        return false;
+
+    /* Info output */
+    std::cout << "Done." << std::endl;
+
+    /* Return result */
+    return true;
+}
@@ -0,0 +1,332 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "batchoptions.h"
+
+/* Function to register command line options (validator mode only offered by the GUI) */
+void addBatchOptions(QCommandLineParser* parser, bool validator)
+{
+    /* Mode */
+    parser->addOption(QCommandLineOption(QStringList() << "m" << "mode",
+            QCoreApplication::translate("main", "Application mode"),
+            validator ? QCoreApplication::translate("main", "validator(default) | exporter | ymlconverter | ymltobinary | binarytoyml")
+                      : QCoreApplication::translate("main", "exporter | ymlconverter | ymltobinary | binarytoyml")));
+
+    /* Input image */
+    parser->addOption(QCommandLineOption(QStringList() << "i" << "input-image",
+            QCoreApplication::translate("main", "Input image path."),
+            QCoreApplication::translate("main", "file path")));
+
+    /* Detector YML path */
+    parser->addOption(QCommandLineOption(QStringList() << "d" << "detector-yml",
+            QCoreApplication::translate("main", "Detector YML path."),
+            QCoreApplication::translate("main", "file path")));
+
+    /* Destination YML path */
+    parser->addOption(QCommandLineOption(QStringList() << "o" << "destination-yml",
+            QCoreApplication::translate("main", "Destination YML path."),
+            QCoreApplication::translate("main", "file path")));
+
+    /* Binary objects file path */
+    parser->addOption(QCommandLineOption(QStringList() << "b" << "binary",
+            QCoreApplication::translate("main", "Binary objects file path."),
+            QCoreApplication::translate("main", "file path (default <destination yml>.bin)")));
+
+    /* Export path */
+    parser->addOption(QCommandLineOption(QStringList() << "e" << "export-path",
+            QCoreApplication::translate("main", "Export path"),
+            QCoreApplication::translate("main", "path")));
+
+    /* Export zoom level */
+    parser->addOption(QCommandLineOption(QStringList() << "z" << "export-zoom",
+            QCoreApplication::translate("main", "Export zoom level"),
+            QCoreApplication::translate("main", "zoomlevel (default 1.0)")));
+
+    /* Export jobs */
+    parser->addOption(QCommandLineOption(QStringList() << "j" << "jobs",
+            QCoreApplication::translate("main", "Number of tiles exported in parallel"),
+            QCoreApplication::translate("main", "count (default number of cores)")));
+
+    /* Export manifest */
+    parser->addOption(QCommandLineOption(QStringList() << "M" << "manifest",
+            QCoreApplication::translate("main", "Manifest of \"<image path> <validated yml path>\" lines to export"),
+            QCoreApplication::translate("main", "file path")));
+
+    /* In-flight panoramas */
+    parser->addOption(QCommandLineOption(QStringList() << "n" << "in-flight",
+            QCoreApplication::translate("main", "Number of panoramas kept in memory by manifest export"),
+            QCoreApplication::translate("main", "count (default 2)")));
+
+    /* Shard size */
+    parser->addOption(QCommandLineOption(QStringList() << "s" << "shard-size",
+            QCoreApplication::translate("main", "Pack tiles into tar shards of given size instead of individual files"),
+            QCoreApplication::translate("main", "megabytes")));
+
+    /* Export format */
+    parser->addOption(QCommandLineOption(QStringList() << "f" << "export-format",
+            QCoreApplication::translate("main", "Tiles image format"),
+            QCoreApplication::translate("main", "png(default) | jpeg | webp | raw")));
+
+    /* Export quality */
+    parser->addOption(QCommandLineOption(QStringList() << "q" << "export-quality",
+            QCoreApplication::translate("main", "Tiles encoding quality (0-100, png: lower is stronger compression)"),
+            QCoreApplication::translate("main", "quality (default codec default)")));
+
+    /* Export size */
+    parser->addOption(QCommandLineOption(QStringList() << "t" << "export-size",
+            QCoreApplication::translate("main", "Tiles size, objects are warped directly to this resolution"),
+            QCoreApplication::translate("main", "WxH (default selection size)")));
+}
+
+/* Function to parse and check processed command line options, false if arguments are invalid or missing */
+bool parseBatchOptions(const QCommandLineParser &parser, bool validator, batch_arguments_struct* arguments)
+{
+    /* Parse application mode in lower case */
+    QString mode_name = parser.value("mode").toLower();
+
+    /* Validator mode by default (GUI only) */
+    if( validator && ( mode_name.length() <= 0 || mode_name == "validator" ) )
+    {
+        arguments->mode = ApplicationMode::Validator;
+
+    /* Exporter */
+    } else if(mode_name == "exporter") {
+        arguments->mode = ApplicationMode::Exporter;
+
+    /* YMLConverter */
+    } else if( mode_name == "ymlconverter" ) {
+        arguments->mode = ApplicationMode::YMLConverter;
+
+    /* YMLToBinary */
+    } else if( mode_name == "ymltobinary" ) {
+        arguments->mode = ApplicationMode::YMLToBinary;
+
+    /* BinaryToYML */
+    } else if( mode_name == "binarytoyml" ) {
+        arguments->mode = ApplicationMode::BinaryToYML;
+
+    /* Invalid mode specified */
+    } else {
+        std::cout << "[ERROR] Invalid mode: " << mode_name.toStdString() << std::endl;
+        return false;
+    }
+
+    /* Parse given paths */
+    arguments->sourceImagePath = parser.value("input-image");
+    arguments->detectorYMLPath = parser.value("detector-yml");
+    arguments->destinationYMLPath = parser.value("destination-yml");
+    arguments->binaryPath = parser.value("binary");
+    arguments->exportPath = parser.value("export-path");
+    arguments->manifestPath = parser.value("manifest");
+
+    /* Export options */
+    export_options_struct* export_options = &arguments->export_options;
+
+    /* Parse zoom level */
+    QString exportZoom = parser.value("export-zoom");
+    export_options->zoom = exportZoom.length() > 0 ? exportZoom.toFloat() : 1.0;
+
+    /* Parse export jobs */
+    QString exportJobs = parser.value("jobs");
+    bool jobsValid = true;
+    export_options->jobs = exportJobs.length() > 0 ? exportJobs.toInt( &jobsValid ) : QThread::idealThreadCount();
+
+    /* Parse in-flight panoramas */
+    QString inflight = parser.value("in-flight");
+    bool inflightValid = true;
+    export_options->inflight = inflight.length() > 0 ? inflight.toInt( &inflightValid ) : 2;
+
+    /* Parse shard size */
+    QString shardSize = parser.value("shard-size");
+    bool shardSizeValid = true;
+    qint64 shardSizeMB = shardSize.length() > 0 ? shardSize.toLongLong( &shardSizeValid ) : 0;
+    export_options->shard_size = shardSizeMB * 1024 * 1024;
+
+    /* Parse export format in lower case */
+    QString exportFormat = parser.value("export-format").toLower();
+    export_options->format = exportFormat.length() > 0 ? exportFormat : "png";
+
+    /* Parse export quality */
+    QString exportQuality = parser.value("export-quality");
+    bool qualityValid = true;
+    export_options->quality = exportQuality.length() > 0 ? exportQuality.toInt( &qualityValid ) : -1;
+
+    /* Parse export size */
+    QStringList exportSize = parser.value("export-size").toLower().split( "x", QString::SkipEmptyParts );
+    export_options->size = exportSize.size() == 2 ? QSize( exportSize[0].toInt(), exportSize[1].toInt() ) : QSize();
+
+    /* Local arguments validity variable */
+    bool argcheck = true;
+
+    /* CHeck source image (manifest export provides its own, binary converters do not need it) */
+    if( arguments->sourceImagePath.length() <= 0 &&
+        !( arguments->mode == ApplicationMode::Exporter && arguments->manifestPath.length() > 0 ) &&
+        arguments->mode != ApplicationMode::YMLToBinary && arguments->mode != ApplicationMode::BinaryToYML )
+    {
+        /* Info output */
+        std::cout << "Missing source image path." << std::endl;
+
+        /* Assign result */
+        argcheck = false;
+    }
+
+    /* Check export size */
+    if( parser.isSet("export-size") && !( export_options->size.width() > 0 && export_options->size.height() > 0 ) )
+    {
+        /* Info output */
+        std::cout << "Invalid export size: " << parser.value("export-size").toStdString() << std::endl;
+
+        /* Assign result */
+        argcheck = false;
+    }
+
+    /* Check jobs count */
+    if( parser.isSet("jobs") && !( jobsValid && export_options->jobs > 0 ) )
+    {
+        /* Info output */
+        std::cout << "Invalid jobs count: " << exportJobs.toStdString() << std::endl;
+
+        /* Assign result */
+        argcheck = false;
+    }
+
+    /* Check in-flight panoramas */
+    if( parser.isSet("in-flight") && !( inflightValid && export_options->inflight > 0 ) )
+    {
+        /* Info output */
+        std::cout << "Invalid in-flight count: " << inflight.toStdString() << std::endl;
+
+        /* Assign result */
+        argcheck = false;
+    }
+
+    /* Check shard size */
+    if( parser.isSet("shard-size") && !( shardSizeValid && shardSizeMB > 0 ) )
+    {
+        /* Info output */
+        std::cout << "Invalid shard size: " << shardSize.toStdString() << std::endl;
+
+        /* Assign result */
+        argcheck = false;
+    }
+
+    /* Check export quality */
+    if( parser.isSet("export-quality") && !( qualityValid && export_options->quality >= 0 && export_options->quality <= 100 ) )
+    {
+        /* Info output */
+        std::cout << "Invalid export quality: " << exportQuality.toStdString() << std::endl;
+
+        /* Assign result */
+        argcheck = false;
+    }
+
+    /* Check export path */
+    if( arguments->mode == ApplicationMode::Exporter && arguments->exportPath.length() <= 0 )
+    {
+        /* Info output */
+        std::cout << "Export path missing." << std::endl;
+
+        /* Assign result */
+        argcheck = false;
+    }
+
+    /* Check detector YML path */
+    if( arguments->mode == ApplicationMode::YMLConverter && arguments->detectorYMLPath.length() <= 0 )
+    {
+        /* Info output */
+        std::cout << "Missing detector YML path." << std::endl;
+
+        /* Assign result */
+        argcheck = false;
+    }
+
+    /* Check destination YML path */
+    if( ( arguments->mode == ApplicationMode::YMLToBinary || arguments->mode == ApplicationMode::BinaryToYML ) &&
+        arguments->destinationYMLPath.length() <= 0 )
+    {
+        /* Info output */
+        std::cout << "Missing destination YML path." << std::endl;
+
+        /* Assign result */
+        argcheck = false;
+    }
+
+    /* Return result */
+    return argcheck;
+}
+
+/* Function to run a batch mode (every mode but validator) */
+bool runBatchMode(const batch_arguments_struct &arguments)
+{
+    /* Application modes switch */
+    switch(arguments.mode)
+    {
+
+    /* Exporter */
+    case ApplicationMode::Exporter:
+
+        /* Export objects tiles of every manifest panorama */
+        if( arguments.manifestPath.length() > 0 )
+            return exportManifest( arguments.manifestPath, arguments.exportPath, arguments.export_options );
+
+        /* Export objects tiles of a single panorama */
+        return exportObjects( arguments.sourceImagePath, arguments.destinationYMLPath, arguments.exportPath, arguments.export_options );
+
+    /* YML Converter */
+    case ApplicationMode::YMLConverter:
+
+        /* Convert detector YML */
+        return convertYML( arguments.sourceImagePath, arguments.detectorYMLPath, arguments.destinationYMLPath );
+
+    /* YML to binary converter */
+    case ApplicationMode::YMLToBinary:
+
+        /* Convert validated YML */
+        return convertYMLToBinary( arguments.destinationYMLPath, arguments.binaryPath );
+
+    /* Binary to YML converter */
+    case ApplicationMode::BinaryToYML:
+
+        /* Convert binary objects file */
+        return convertBinaryToYML( arguments.binaryPath, arguments.destinationYMLPath );
+    }
+
+    /* Not a batch mode */
+    return false;
+}
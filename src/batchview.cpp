@@ -145,7 +145,7 @@ void BatchView::populate(int batchviewmode)
 
             /* Check if rect is a valid face */
             if(rect->getObjectType() == ObjectType::Face &&
-                    (rect->getAutomaticStatus() == "Valid" || rect->getAutomaticStatus() == "None"))
+                    (rect->getAutomaticStatus() == ObjectAutomaticStatus::Valid || rect->getAutomaticStatus() == ObjectAutomaticStatus::None))
             {
                 /* Insert tile */
                 this->insertItem(rect);
@@ -157,8 +157,8 @@ void BatchView::populate(int batchviewmode)
 
             /* Check if rect is unnaproved */
             if(rect->getObjectType() == ObjectType::Face
-                    && rect->getManualStatus() == "None"
-                    && rect->getAutomaticStatus() == "Valid")
+                    && rect->getManualStatus() == ObjectManualStatus::None
+                    && rect->getAutomaticStatus() == ObjectAutomaticStatus::Valid)
             {
                 /* Insert tile */
                 this->insertItem(rect);
@@ -181,8 +181,8 @@ void BatchView::populate(int batchviewmode)
 
             /* Check if rect is an unnaproved numberplate */
             if(rect->getObjectType() == ObjectType::NumberPlate
-                    && rect->getManualStatus() == "None"
-                    && rect->getAutomaticStatus() == "Valid")
+                    && rect->getManualStatus() == ObjectManualStatus::None
+                    && rect->getAutomaticStatus() == ObjectAutomaticStatus::Valid)
             {
                 /* Insert tile */
                 this->insertItem(rect);
@@ -194,8 +194,8 @@ void BatchView::populate(int batchviewmode)
 
             /* Check if rect is pre-invalidated */
             if(rect->getObjectType() != ObjectType::None
-                    && rect->getAutomaticStatus() != "Valid"
-                    && rect->getAutomaticStatus() != "None")
+                    && rect->getAutomaticStatus() != ObjectAutomaticStatus::Valid
+                    && rect->getAutomaticStatus() != ObjectAutomaticStatus::None)
             {
                 /* Insert tile */
                 this->insertItem(rect);
@@ -422,7 +422,7 @@ void BatchView::on_ValidateButton_clicked()
         {
             /* Mark object as valid */
             item->setItemManualState( ObjectManualState::Valid );
-            item->setManualStatus("Valid");
+            item->setManualStatus(ObjectManualStatus::Valid);
         }
     }
 }
@@ -438,7 +438,7 @@ void BatchView::on_InvalidateButton_clicked()
         {
             /* Mark object as invalid */
             item->setItemManualState( ObjectManualState::Invalid );
-            item->setManualStatus("Invalid");
+            item->setManualStatus(ObjectManualStatus::Invalid);
         }
     }
 }
@@ -514,7 +514,7 @@ void BatchView::on_ApplyButton_clicked()
     foreach(ObjectItem* item, this->elements)
     {
         /* Check if object is unnaproved */
-        if(item->getManualStatus() == "None")
+        if(item->getManualStatus() == ObjectManualStatus::None)
         {
             /* Assign flag */
             haveNoManualState = true;
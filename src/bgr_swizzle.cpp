@@ -0,0 +1,214 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "bgr_swizzle.h"
+
+/* SSSE3 row converters are only built for x86 targets with GCC compatible compilers */
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#define BGR_SWIZZLE_SIMD
+#include <immintrin.h>
+#endif
+
+/* Function to convert a grayscale row (scalar) */
+static void bgr_swizzle_gray(const uchar* src, quint32* dst, int x, int width)
+{
+    /* Iterate over remaining pixels */
+    for( ; x < width; x++ )
+        dst[x] = 0xFF000000 | ( src[x] << 16 ) | ( src[x] << 8 ) | src[x];
+}
+
+/* Function to convert a BGR row (scalar) */
+static void bgr_swizzle_bgr(const uchar* src, quint32* dst, int x, int width)
+{
+    /* Iterate over remaining pixels */
+    for( ; x < width; x++ )
+        dst[x] = 0xFF000000 | ( src[x * 3 + 2] << 16 ) | ( src[x * 3 + 1] << 8 ) | src[x * 3];
+}
+
+/* Function to convert a BGRA row (scalar) */
+static void bgr_swizzle_bgra(const uchar* src, quint32* dst, int x, int width)
+{
+    /* Iterate over remaining pixels */
+    for( ; x < width; x++ )
+        dst[x] = ( src[x * 4 + 3] << 24 ) | ( src[x * 4 + 2] << 16 ) | ( src[x * 4 + 1] << 8 ) | src[x * 4];
+}
+
+#ifdef BGR_SWIZZLE_SIMD
+
+/* Function to convert a grayscale row (SSSE3, 16 pixels per iteration) */
+__attribute__((target("ssse3")))
+static void bgr_swizzle_gray_ssse3(const uchar* src, quint32* dst, int width)
+{
+    /* Byte replication masks (one per group of 4 pixels) */
+    const __m128i mask0 = _mm_setr_epi8(  0,  0,  0, -1,  1,  1,  1, -1,  2,  2,  2, -1,  3,  3,  3, -1 );
+    const __m128i mask1 = _mm_setr_epi8(  4,  4,  4, -1,  5,  5,  5, -1,  6,  6,  6, -1,  7,  7,  7, -1 );
+    const __m128i mask2 = _mm_setr_epi8(  8,  8,  8, -1,  9,  9,  9, -1, 10, 10, 10, -1, 11, 11, 11, -1 );
+    const __m128i mask3 = _mm_setr_epi8( 12, 12, 12, -1, 13, 13, 13, -1, 14, 14, 14, -1, 15, 15, 15, -1 );
+    const __m128i alpha = _mm_set1_epi32( (int) 0xFF000000 );
+
+    /* Iterate over row, 16 pixels at a time */
+    int x = 0;
+    for( ; x + 16 <= width; x += 16 )
+    {
+        /* Load pixels */
+        __m128i p = _mm_loadu_si128( (const __m128i*) ( src + x ) );
+
+        /* Replicate channels and store opaque pixels */
+        _mm_storeu_si128( (__m128i*) ( dst + x ), _mm_or_si128( _mm_shuffle_epi8( p, mask0 ), alpha ) );
+        _mm_storeu_si128( (__m128i*) ( dst + x + 4 ), _mm_or_si128( _mm_shuffle_epi8( p, mask1 ), alpha ) );
+        _mm_storeu_si128( (__m128i*) ( dst + x + 8 ), _mm_or_si128( _mm_shuffle_epi8( p, mask2 ), alpha ) );
+        _mm_storeu_si128( (__m128i*) ( dst + x + 12 ), _mm_or_si128( _mm_shuffle_epi8( p, mask3 ), alpha ) );
+    }
+
+    /* Process remaining pixels */
+    bgr_swizzle_gray( src, dst, x, width );
+}
+
+/* Function to convert a BGR row (SSSE3, 16 pixels per iteration) */
+__attribute__((target("ssse3")))
+static void bgr_swizzle_bgr_ssse3(const uchar* src, quint32* dst, int width)
+{
+    /* Byte expansion mask (4 BGR pixels into 4 BGRA pixels) */
+    const __m128i mask = _mm_setr_epi8( 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1 );
+    const __m128i alpha = _mm_set1_epi32( (int) 0xFF000000 );
+
+    /* Iterate over row, 16 pixels (48 bytes) at a time */
+    int x = 0;
+    for( ; x + 16 <= width; x += 16 )
+    {
+        /* Load pixels */
+        const uchar* s = src + x * 3;
+        __m128i a = _mm_loadu_si128( (const __m128i*) ( s ) );
+        __m128i b = _mm_loadu_si128( (const __m128i*) ( s + 16 ) );
+        __m128i c = _mm_loadu_si128( (const __m128i*) ( s + 32 ) );
+
+        /* Align each group of 4 pixels on register start */
+        __m128i p0 = a;
+        __m128i p1 = _mm_alignr_epi8( b, a, 12 );
+        __m128i p2 = _mm_alignr_epi8( c, b, 8 );
+        __m128i p3 = _mm_srli_si128( c, 4 );
+
+        /* Expand pixels and store opaque pixels */
+        _mm_storeu_si128( (__m128i*) ( dst + x ), _mm_or_si128( _mm_shuffle_epi8( p0, mask ), alpha ) );
+        _mm_storeu_si128( (__m128i*) ( dst + x + 4 ), _mm_or_si128( _mm_shuffle_epi8( p1, mask ), alpha ) );
+        _mm_storeu_si128( (__m128i*) ( dst + x + 8 ), _mm_or_si128( _mm_shuffle_epi8( p2, mask ), alpha ) );
+        _mm_storeu_si128( (__m128i*) ( dst + x + 12 ), _mm_or_si128( _mm_shuffle_epi8( p3, mask ), alpha ) );
+    }
+
+    /* Process remaining pixels */
+    bgr_swizzle_bgr( src, dst, x, width );
+}
+
+/* Function to convert a BGRA row (SSE2, BGRA already matches little-endian ARGB32 layout) */
+__attribute__((target("sse2")))
+static void bgr_swizzle_bgra_sse2(const uchar* src, quint32* dst, int width)
+{
+    /* Iterate over row, 4 pixels at a time */
+    int x = 0;
+    for( ; x + 4 <= width; x += 4 )
+        _mm_storeu_si128( (__m128i*) ( dst + x ), _mm_loadu_si128( (const __m128i*) ( src + x * 4 ) ) );
+
+    /* Process remaining pixels */
+    bgr_swizzle_bgra( src, dst, x, width );
+}
+
+#endif // BGR_SWIZZLE_SIMD
+
+/* Function to convert a packed BGR, BGRA or grayscale 8 bits buffer into an ARGB32 QImage */
+void bgr_swizzle_image(const uchar* data,
+                       int step,
+                       int channels,
+                       QImage* dest,
+                       int threads)
+{
+    /* Image dimensions */
+    int width = dest->width();
+    int height = dest->height();
+
+    /* Destination image data (scanLine() is not called inside parallel region to avoid detach checks) */
+    uchar* d_bits = dest->bits();
+    int d_stride = dest->bytesPerLine();
+
+#ifdef BGR_SWIZZLE_SIMD
+    /* Detect SSSE3 support */
+    __builtin_cpu_init();
+    bool ssse3 = __builtin_cpu_supports( "ssse3" );
+#endif
+
+    /* Iterate over image Y axis */
+    #pragma omp parallel for num_threads( threads ) schedule( static )
+    for( int y = 0; y < height; y++ )
+    {
+        /* Source and destination rows */
+        const uchar* src = data + ( (size_t) y * step );
+        quint32* dst = (quint32*) ( d_bits + ( (size_t) y * d_stride ) );
+
+        /* Channels switch */
+        switch( channels )
+        {
+        case 1:
+#ifdef BGR_SWIZZLE_SIMD
+            if( ssse3 ) { bgr_swizzle_gray_ssse3( src, dst, width ); break; }
+#endif
+            bgr_swizzle_gray( src, dst, 0, width );
+            break;
+
+        case 3:
+#ifdef BGR_SWIZZLE_SIMD
+            if( ssse3 ) { bgr_swizzle_bgr_ssse3( src, dst, width ); break; }
+#endif
+            bgr_swizzle_bgr( src, dst, 0, width );
+            break;
+
+        case 4:
+#ifdef BGR_SWIZZLE_SIMD
+            bgr_swizzle_bgra_sse2( src, dst, width );
+#else
+            bgr_swizzle_bgra( src, dst, 0, width );
+#endif
+            break;
+
+        default:
+            /* Unsupported layout, fill with opaque black */
+            for( int x = 0; x < width; x++ )
+                dst[x] = 0xFF000000;
+            break;
+        }
+    }
+}
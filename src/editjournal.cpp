@@ -0,0 +1,402 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "editjournal.h"
+
+/* Function to serialize an object (childrens included) */
+static QJsonObject recordToJson(const ObjectRecord &record)
+{
+    /* Object container */
+    QJsonObject object;
+
+    /* Object infos */
+    object["type"] = record.type;
+    object["subType"] = record.sub_type;
+    object["automaticState"] = record.automatic_state;
+    object["manualState"] = record.manual_state;
+    object["blurred"] = record.blurred;
+    object["automaticStatus"] = record.automatic_status;
+    object["manualStatus"] = record.manual_status;
+
+    /* Projection parameters */
+    object["azimuth"] = record.azimuth;
+    object["elevation"] = record.elevation;
+    object["aperture"] = record.aperture;
+    object["width"] = record.width;
+    object["height"] = record.height;
+
+    /* Projection points */
+    QJsonArray points;
+    for( int i = 0; i < 4; i++ )
+        points.append( QJsonArray() << record.points[i].x() << record.points[i].y() );
+    object["points"] = points;
+
+    /* Source image path */
+    object["sourceImage"] = record.source_image;
+
+    /* Childrens */
+    if( record.childrens.size() > 0 )
+    {
+        QJsonArray childrens;
+        foreach( const ObjectRecord &child, record.childrens )
+            childrens.append( recordToJson( child ) );
+        object["childrens"] = childrens;
+    }
+
+    /* Return value */
+    return object;
+}
+
+/* Function to deserialize an object (childrens included) */
+static ObjectRecord recordFromJson(const QJsonObject &object)
+{
+    /* Record container */
+    ObjectRecord record;
+
+    /* Object infos */
+    record.type = object["type"].toInt();
+    record.sub_type = object["subType"].toInt();
+    record.automatic_state = object["automaticState"].toInt();
+    record.manual_state = object["manualState"].toInt();
+    record.blurred = object["blurred"].toBool();
+    record.automatic_status = object["automaticStatus"].toInt();
+    record.manual_status = object["manualStatus"].toInt();
+
+    /* Projection parameters */
+    record.azimuth = object["azimuth"].toDouble();
+    record.elevation = object["elevation"].toDouble();
+    record.aperture = object["aperture"].toDouble();
+    record.width = object["width"].toDouble();
+    record.height = object["height"].toDouble();
+
+    /* Projection points */
+    QJsonArray points = object["points"].toArray();
+    for( int i = 0; i < 4 && i < points.size(); i++ )
+    {
+        QJsonArray point = points[i].toArray();
+        record.points[i] = QPointF( point[0].toDouble(), point[1].toDouble() );
+    }
+
+    /* Source image path */
+    record.source_image = object["sourceImage"].toString();
+
+    /* Childrens */
+    foreach( const QJsonValue &child, object["childrens"].toArray() )
+        record.childrens.append( recordFromJson( child.toObject() ) );
+
+    /* Return value */
+    return record;
+}
+
+/* Function to identify YML file content a journal applies to (size and modification time) */
+static QJsonObject ymlFingerprint(QString path)
+{
+    /* YML file infos */
+    QFileInfo info( path );
+
+    /* Fingerprint container (missing YML has no size) */
+    QJsonObject fingerprint;
+    fingerprint["size"] = info.exists() ? (double) info.size() : -1.0;
+    fingerprint["modified"] = info.exists() ? (double) info.lastModified().toMSecsSinceEpoch() : 0.0;
+
+    /* Return value */
+    return fingerprint;
+}
+
+/* Destructor */
+EditJournal::~EditJournal()
+{
+    /* Close journal, keep it on disk for next session */
+    if( this->file.isOpen() )
+        this->file.close();
+}
+
+/* Function to get journal path of a YML file */
+QString EditJournal::journalPath(QString path)
+{
+    /* Return value */
+    return path + ".journal";
+}
+
+/* Function to replay a left over journal onto objects loaded from YML, assigns objects ids, returns replayed entries */
+int EditJournal::replay(QString path, QVector<ObjectRecord>* records, QVector<int>* ids)
+{
+    /* Default ids follow YML order */
+    ids->clear();
+    for( int i = 0; i < records->size(); i++ )
+        ids->append( i );
+
+    /* Open left over journal */
+    QFile journal( EditJournal::journalPath( path ) );
+    if( !journal.open( QIODevice::ReadOnly ) )
+        return 0;
+
+    /* Read header (YML fingerprint and ids of YML objects when journal was started) */
+    QJsonObject header = QJsonDocument::fromJson( journal.readLine() ).object();
+    QJsonArray base = header["base"].toArray();
+
+    /* Journal does not belong to this YML anymore (YML rewritten or replaced since) */
+    if( header["yml"].toObject() != ymlFingerprint( path ) || base.size() != records->size() )
+    {
+        /* Info output */
+        std::cout << "Ignoring outdated journal: " << journal.fileName().toStdString() << std::endl;
+        return 0;
+    }
+
+    /* Assign journaled ids */
+    for( int i = 0; i < base.size(); i++ )
+        (*ids)[i] = base[i].toInt();
+
+    /* Replayed entries counter */
+    int replayed = 0;
+
+    /* Replay entries (a torn last line ends the journal) */
+    while( !journal.atEnd() )
+    {
+        /* Parse entry */
+        QJsonParseError error;
+        QJsonObject entry = QJsonDocument::fromJson( journal.readLine(), &error ).object();
+        if( error.error != QJsonParseError::NoError )
+            break;
+
+        /* Entry target */
+        int id = entry["id"].toInt();
+        int index = ids->indexOf( id );
+
+        /* Created / modified object */
+        if( entry["op"].toString() == "upsert" )
+        {
+            /* Deserialize object */
+            ObjectRecord record = recordFromJson( entry["object"].toObject() );
+
+            /* Replace or append object */
+            if( index >= 0 )
+            {
+                (*records)[index] = record;
+            } else {
+                records->append( record );
+                ids->append( id );
+            }
+
+        /* Deleted object */
+        } else if( entry["op"].toString() == "delete" && index >= 0 ) {
+            records->remove( index );
+            ids->remove( index );
+        }
+
+        /* Update counter */
+        replayed++;
+    }
+
+    /* Info output */
+    if( replayed > 0 )
+        std::cout << "Replayed " << replayed << " journaled edits." << std::endl;
+
+    /* Return value */
+    return replayed;
+}
+
+/* Function to start a fresh journal from current objects */
+bool EditJournal::begin(QString path, const QVector<int> &ids, const QVector<ObjectRecord> &records)
+{
+    /* Close previous journal */
+    if( this->file.isOpen() )
+        this->file.close();
+
+    /* Snapshot journaled objects */
+    this->yml_path = path;
+    this->state.clear();
+    for( int i = 0; i < ids.size(); i++ )
+        this->state.insert( ids[i], records[i] );
+
+    /* Header (ids of YML objects) */
+    QJsonArray base;
+    foreach( int id, ids )
+        base.append( id );
+
+    /* Create journal (unbuffered, failed appends are rolled back) */
+    this->file.setFileName( EditJournal::journalPath( path ) );
+    if( !this->file.open( QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered ) )
+    {
+        /* Info output */
+        std::cout << "Unable to create journal: " << this->file.fileName().toStdString() << std::endl;
+        return false;
+    }
+
+    /* Write header */
+    QJsonObject header;
+    header["yml"] = ymlFingerprint( path );
+    header["base"] = base;
+    return this->writeLine( header );
+}
+
+/* Function to continue a replayed journal from current objects (journal kept as is) */
+bool EditJournal::resume(QString path, const QVector<int> &ids, const QVector<ObjectRecord> &records)
+{
+    /* Close previous journal */
+    if( this->file.isOpen() )
+        this->file.close();
+
+    /* Snapshot journaled objects (replayed state) */
+    this->yml_path = path;
+    this->state.clear();
+    for( int i = 0; i < ids.size(); i++ )
+        this->state.insert( ids[i], records[i] );
+
+    /* Reopen journal after its last entry */
+    this->file.setFileName( EditJournal::journalPath( path ) );
+    if( !this->file.open( QIODevice::WriteOnly | QIODevice::Append | QIODevice::Unbuffered ) )
+    {
+        /* Info output */
+        std::cout << "Unable to open journal: " << this->file.fileName().toStdString() << std::endl;
+        return false;
+    }
+
+    /* Return result */
+    return true;
+}
+
+/* Function to append changes between journaled and current objects, returns written entries, -1 on write failure */
+int EditJournal::append(const QVector<int> &ids, const QVector<ObjectRecord> &records)
+{
+    /* Check journal */
+    if( !this->file.isOpen() )
+        return 0;
+
+    /* Written entries counter / write result */
+    int written = 0;
+    bool success = true;
+
+    /* Journal size before this batch */
+    qint64 start = this->file.size();
+
+    /* Journal created / modified objects */
+    QHash<int, ObjectRecord> current;
+    for( int i = 0; i < ids.size(); i++ )
+    {
+        /* Keep first object of an id */
+        if( current.contains( ids[i] ) )
+            continue;
+        current.insert( ids[i], records[i] );
+
+        /* Skip unchanged objects */
+        QHash<int, ObjectRecord>::const_iterator it = this->state.constFind( ids[i] );
+        if( it != this->state.constEnd() && it.value() == records[i] )
+            continue;
+
+        /* Write upsert entry */
+        QJsonObject entry;
+        entry["op"] = QString( "upsert" );
+        entry["id"] = ids[i];
+        entry["object"] = recordToJson( records[i] );
+        success = this->writeLine( entry ) && success;
+        written++;
+    }
+
+    /* Journal deleted objects */
+    for( QHash<int, ObjectRecord>::const_iterator it = this->state.constBegin(); it != this->state.constEnd(); ++it )
+    {
+        /* Skip remaining objects */
+        if( current.contains( it.key() ) )
+            continue;
+
+        /* Write delete entry */
+        QJsonObject entry;
+        entry["op"] = QString( "delete" );
+        entry["id"] = it.key();
+        success = this->writeLine( entry ) && success;
+        written++;
+    }
+
+    /* Drop partially written batch, changes are journaled again by next call */
+    if( !success )
+    {
+        /* Info output */
+        std::cout << "Unable to write journal: " << this->file.fileName().toStdString() << std::endl;
+
+        /* Restore journal size */
+        this->file.resize( start );
+        this->file.seek( start );
+
+        /* Return result */
+        return -1;
+    }
+
+    /* Entries are on disk */
+    if( written > 0 )
+        this->state = current;
+
+    /* Return value */
+    return written;
+}
+
+/* Function to fold current objects into YML file and restart journal (journal kept if YML could not be written) */
+bool EditJournal::compact(QString path, const QVector<int> &ids, const QVector<ObjectRecord> &records)
+{
+    /* Write whole YML */
+    YMLParser parser;
+    if( !parser.writeYML( records, path ) )
+        return false;
+
+    /* Restart journal from written objects */
+    return this->begin( path, ids, records );
+}
+
+/* Function to close and delete journal (changes saved or discarded) */
+void EditJournal::discard()
+{
+    /* Close journal */
+    if( this->file.isOpen() )
+        this->file.close();
+
+    /* Delete journal */
+    if( this->file.fileName().length() > 0 )
+        QFile::remove( this->file.fileName() );
+
+    /* Reset state */
+    this->state.clear();
+}
+
+/* Function to append a line to journal */
+bool EditJournal::writeLine(const QJsonObject &line)
+{
+    /* Write compact JSON line (whole line or failure) */
+    QByteArray data = QJsonDocument( line ).toJson( QJsonDocument::Compact ) + '\n';
+    return this->file.write( data ) == data.size();
+}
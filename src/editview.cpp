@@ -114,7 +114,7 @@ EditView::EditView(QWidget *parent, ObjectRect* rect, image_info_struct image_in
     this->pano->setEditEnabled( false );
 
     /* Check if rect have an automatic status */
-    if (this->ref_rect->getAutomaticStatus() != "None")
+    if (this->ref_rect->getAutomaticStatus() != ObjectAutomaticStatus::None)
     {
         /* Configure panorama features */
         this->ui->typeList->setEnabled( false );
@@ -242,7 +242,7 @@ EditView::EditView(QWidget *parent, ObjectRect* rect, image_info_struct image_in
     this->ui->heightLabel->setText("Height: " + QString::number( (int) this->ref_rect->getSize().height() ));
 
     /* Set pre-filter label text */
-    this->ui->preFiltersLabel->setText("Pre-filter status: " + this->ref_rect->getAutomaticStatus());
+    this->ui->preFiltersLabel->setText("Pre-filter status: " + this->ref_rect->toRecord().automaticStatusName());
 
     /* Assign checkboxes default values */
     this->ui->validCheckBox->setChecked( this->ref_rect->isValidated() );
@@ -438,7 +438,7 @@ void EditView::mergeEditedItem(ObjectItem* destination)
     }
 
     /* Set manual status */
-    destination->setManualStatus( this->ui->validCheckBox->checkState() ? "Valid" : "Invalid" );
+    destination->setManualStatus( this->ui->validCheckBox->checkState() ? ObjectManualStatus::Valid : ObjectManualStatus::Invalid );
 
     /* Set blur */
     destination->setBlurred( this->ui->blurCheckBox->checkState() );
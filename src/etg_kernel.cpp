@@ -0,0 +1,870 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "etg_kernel.h"
+
+/* SIMD kernels are only built for x86 targets with GCC compatible compilers */
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#define ETG_KERNEL_SIMD
+#include <immintrin.h>
+#endif
+
+/* Number of destination pixels processed per chunk by direct projection */
+#define ETG_KERNEL_CHUNK 256
+
+/* Arc-tangent polynomial coefficients on [0, 1] (maximal error about 1e-5 rad) */
+#define ETG_ATAN_C0 (  0.99997726f )
+#define ETG_ATAN_C1 ( -0.33262347f )
+#define ETG_ATAN_C2 (  0.19354346f )
+#define ETG_ATAN_C3 ( -0.11643287f )
+#define ETG_ATAN_C4 (  0.05265332f )
+#define ETG_ATAN_C5 ( -0.01172120f )
+
+/* Function to assign a remap entry from equirectangular coordinates */
+static inline void etg_entry(const etg_frame_struct* frame,
+                             double e_x,
+                             double e_y,
+                             remap_entry_struct* entry)
+{
+    /* Top-left neighbour, kept inside image so that all four neighbours exist */
+    int x0 = qBound( 0, (int) e_x, frame->s_width - 2 );
+    int y0 = qBound( 0, (int) e_y, frame->s_height - 2 );
+
+    /* Assign entry */
+    entry->offset = ( y0 * frame->s_stride ) + x0;
+    entry->weight_x = qBound( 0, (int) ( ( e_x - x0 ) * 256.0 + 0.5 ), 256 );
+    entry->weight_y = qBound( 0, (int) ( ( e_y - y0 ) * 256.0 + 0.5 ), 256 );
+}
+
+/* Function to blend two ARGB32 pixels with a 0 - 256 weight */
+static inline quint32 etg_blend(quint32 a, quint32 b, quint32 weight)
+{
+    /* Blend red and blue channels */
+    quint32 rb = ( ( ( a & 0x00FF00FF ) * ( 256 - weight ) + ( b & 0x00FF00FF ) * weight ) >> 8 ) & 0x00FF00FF;
+
+    /* Blend alpha and green channels */
+    quint32 ag = ( ( ( a >> 8 ) & 0x00FF00FF ) * ( 256 - weight ) + ( ( b >> 8 ) & 0x00FF00FF ) * weight ) & 0xFF00FF00;
+
+    /* Return result */
+    return ( rb | ag );
+}
+
+/* Function to compute remap entries of a destination row segment (scalar) */
+static void etg_coords_scalar(const etg_frame_struct* frame,
+                              int y,
+                              int x,
+                              int count,
+                              remap_entry_struct* entries)
+{
+    /* Compute vertical position in rectilinear frame */
+    double pi2 = ( y - frame->center_y ) * frame->pixel_y;
+
+    /* Iterate over row segment */
+    for( int i = 0; i < count; i++ )
+    {
+        /* Compute horizontal position in rectilinear frame */
+        double pi1 = ( x + i - frame->center_x ) * frame->pixel_x;
+
+        /* Apply rotation on position */
+        double pf0 = frame->m[0][0] + frame->m[0][1] * pi1 + frame->m[0][2] * pi2;
+        double pf1 = frame->m[1][0] + frame->m[1][1] * pi1 + frame->m[1][2] * pi2;
+        double pf2 = frame->m[2][0] + frame->m[2][1] * pi1 + frame->m[2][2] * pi2;
+
+        /* Compute spherical angles */
+        double s_x = atan2( pf1, pf0 );
+        double s_y = atan2( pf2, sqrt( pf0 * pf0 + pf1 * pf1 ) );
+
+        /* Wrap azimuth angle */
+        if( s_x < 0.0 ) s_x += LG_PI2;
+
+        /* Assign entry from position in equirectangular image */
+        etg_entry( frame,
+                   ( s_x / LG_PI2 ) * ( frame->s_width - 1 ),
+                   ( ( s_y / LG_PI ) + 0.5 ) * ( frame->s_height - 1 ),
+                   entries + i );
+    }
+}
+
+/* Function to interpolate destination pixels from remap entries (scalar) */
+static void etg_gather_scalar(const quint32* s_bits,
+                              int s_stride,
+                              const remap_entry_struct* entries,
+                              int count,
+                              quint32* line)
+{
+    /* Iterate over entries */
+    for( int i = 0; i < count; i++ )
+    {
+        /* Get neighbours */
+        const quint32* p = s_bits + entries[i].offset;
+
+        /* Interpolate rows */
+        quint32 top = etg_blend( p[0], p[1], entries[i].weight_x );
+        quint32 bottom = etg_blend( p[s_stride], p[s_stride + 1], entries[i].weight_x );
+
+        /* Interpolate columns and assign opaque pixel */
+        line[i] = etg_blend( top, bottom, entries[i].weight_y ) | 0xFF000000;
+    }
+}
+
+#ifdef ETG_KERNEL_SIMD
+
+/* Function to approximate arc-tangent of y / x on 8 lanes (AVX2) */
+__attribute__((target("avx2,fma")))
+static inline __m256 etg_atan2_avx2(__m256 y, __m256 x)
+{
+    /* Constants */
+    const __m256 sign = _mm256_set1_ps( -0.0f );
+    const __m256 tiny = _mm256_set1_ps( 1e-30f );
+    const __m256 half_pi = _mm256_set1_ps( (float) ( LG_PI / 2.0 ) );
+    const __m256 pi = _mm256_set1_ps( (float) LG_PI );
+
+    /* Reduce ratio to [0, 1] */
+    __m256 ax = _mm256_andnot_ps( sign, x );
+    __m256 ay = _mm256_andnot_ps( sign, y );
+    __m256 a = _mm256_div_ps( _mm256_min_ps( ax, ay ), _mm256_max_ps( _mm256_max_ps( ax, ay ), tiny ) );
+    __m256 s = _mm256_mul_ps( a, a );
+
+    /* Evaluate polynomial */
+    __m256 r = _mm256_fmadd_ps( _mm256_set1_ps( ETG_ATAN_C5 ), s, _mm256_set1_ps( ETG_ATAN_C4 ) );
+    r = _mm256_fmadd_ps( r, s, _mm256_set1_ps( ETG_ATAN_C3 ) );
+    r = _mm256_fmadd_ps( r, s, _mm256_set1_ps( ETG_ATAN_C2 ) );
+    r = _mm256_fmadd_ps( r, s, _mm256_set1_ps( ETG_ATAN_C1 ) );
+    r = _mm256_fmadd_ps( r, s, _mm256_set1_ps( ETG_ATAN_C0 ) );
+    r = _mm256_mul_ps( r, a );
+
+    /* Restore octant and quadrant */
+    r = _mm256_blendv_ps( r, _mm256_sub_ps( half_pi, r ), _mm256_cmp_ps( ay, ax, _CMP_GT_OQ ) );
+    r = _mm256_blendv_ps( r, _mm256_sub_ps( pi, r ), _mm256_cmp_ps( x, _mm256_setzero_ps(), _CMP_LT_OQ ) );
+
+    /* Apply sign of y and return result */
+    return _mm256_xor_ps( r, _mm256_and_ps( y, sign ) );
+}
+
+/* Function to blend two ARGB32 pixels vectors with 0 - 256 weights (AVX2) */
+__attribute__((target("avx2")))
+static inline __m256i etg_blend_avx2(__m256i a, __m256i b, __m256i weight, __m256i inverse)
+{
+    /* Channels mask */
+    const __m256i mask = _mm256_set1_epi32( 0x00FF00FF );
+
+    /* Blend red and blue channels */
+    __m256i rb = _mm256_add_epi16( _mm256_mullo_epi16( _mm256_and_si256( a, mask ), inverse ),
+                                   _mm256_mullo_epi16( _mm256_and_si256( b, mask ), weight ) );
+
+    /* Blend alpha and green channels */
+    __m256i ag = _mm256_add_epi16( _mm256_mullo_epi16( _mm256_and_si256( _mm256_srli_epi32( a, 8 ), mask ), inverse ),
+                                   _mm256_mullo_epi16( _mm256_and_si256( _mm256_srli_epi32( b, 8 ), mask ), weight ) );
+
+    /* Return result */
+    return _mm256_or_si256( _mm256_srli_epi16( rb, 8 ), _mm256_andnot_si256( mask, ag ) );
+}
+
+/* Function to compute remap entries of a destination row segment (AVX2) */
+__attribute__((target("avx2,fma")))
+static void etg_coords_avx2(const etg_frame_struct* frame,
+                            int y,
+                            int x,
+                            int count,
+                            remap_entry_struct* entries)
+{
+    /* Compute row positions in rectilinear frame */
+    double pi1 = - frame->center_x * frame->pixel_x;
+    double pi2 = ( y - frame->center_y ) * frame->pixel_y;
+
+    /* Rotated position of first pixel and increment per pixel */
+    __m256 base0 = _mm256_set1_ps( (float) ( frame->m[0][0] + frame->m[0][1] * pi1 + frame->m[0][2] * pi2 ) );
+    __m256 base1 = _mm256_set1_ps( (float) ( frame->m[1][0] + frame->m[1][1] * pi1 + frame->m[1][2] * pi2 ) );
+    __m256 base2 = _mm256_set1_ps( (float) ( frame->m[2][0] + frame->m[2][1] * pi1 + frame->m[2][2] * pi2 ) );
+    __m256 step0 = _mm256_set1_ps( (float) ( frame->m[0][1] * frame->pixel_x ) );
+    __m256 step1 = _mm256_set1_ps( (float) ( frame->m[1][1] * frame->pixel_x ) );
+    __m256 step2 = _mm256_set1_ps( (float) ( frame->m[2][1] * frame->pixel_x ) );
+
+    /* Equirectangular mapping constants */
+    const __m256 scale_x = _mm256_set1_ps( (float) ( ( frame->s_width - 1 ) / LG_PI2 ) );
+    const __m256 scale_y = _mm256_set1_ps( (float) ( ( frame->s_height - 1 ) / LG_PI ) );
+    const __m256 shift_y = _mm256_set1_ps( (float) ( ( frame->s_height - 1 ) / 2.0 ) );
+    const __m256 two_pi = _mm256_set1_ps( (float) LG_PI2 );
+    const __m256 lanes = _mm256_setr_ps( 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f );
+
+    /* Integer constants */
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i max_x = _mm256_set1_epi32( frame->s_width - 2 );
+    const __m256i max_y = _mm256_set1_epi32( frame->s_height - 2 );
+    const __m256i max_w = _mm256_set1_epi32( 256 );
+    const __m256i stride = _mm256_set1_epi32( frame->s_stride );
+    const __m256 unit = _mm256_set1_ps( 256.0f );
+    const __m256 round = _mm256_set1_ps( 0.5f );
+
+    /* Iterate over row segment, 8 pixels at a time */
+    int i = 0;
+    for( ; i + 8 <= count; i += 8 )
+    {
+        /* Compute rotated positions */
+        __m256 px = _mm256_add_ps( _mm256_set1_ps( (float) ( x + i ) ), lanes );
+        __m256 p0 = _mm256_fmadd_ps( px, step0, base0 );
+        __m256 p1 = _mm256_fmadd_ps( px, step1, base1 );
+        __m256 p2 = _mm256_fmadd_ps( px, step2, base2 );
+
+        /* Compute spherical angles (asin computed as atan2 against horizontal norm) */
+        __m256 s_x = etg_atan2_avx2( p1, p0 );
+        __m256 s_y = etg_atan2_avx2( p2, _mm256_sqrt_ps( _mm256_fmadd_ps( p0, p0, _mm256_mul_ps( p1, p1 ) ) ) );
+
+        /* Wrap azimuth angle */
+        s_x = _mm256_add_ps( s_x, _mm256_and_ps( _mm256_cmp_ps( s_x, _mm256_setzero_ps(), _CMP_LT_OQ ), two_pi ) );
+
+        /* Compute position in equirectangular image */
+        __m256 e_x = _mm256_mul_ps( s_x, scale_x );
+        __m256 e_y = _mm256_fmadd_ps( s_y, scale_y, shift_y );
+
+        /* Compute top-left neighbours */
+        __m256i x0 = _mm256_min_epi32( _mm256_max_epi32( _mm256_cvttps_epi32( e_x ), zero ), max_x );
+        __m256i y0 = _mm256_min_epi32( _mm256_max_epi32( _mm256_cvttps_epi32( e_y ), zero ), max_y );
+
+        /* Compute weights */
+        __m256i wx = _mm256_cvttps_epi32( _mm256_fmadd_ps( _mm256_sub_ps( e_x, _mm256_cvtepi32_ps( x0 ) ), unit, round ) );
+        __m256i wy = _mm256_cvttps_epi32( _mm256_fmadd_ps( _mm256_sub_ps( e_y, _mm256_cvtepi32_ps( y0 ) ), unit, round ) );
+        wx = _mm256_min_epi32( _mm256_max_epi32( wx, zero ), max_w );
+        wy = _mm256_min_epi32( _mm256_max_epi32( wy, zero ), max_w );
+
+        /* Pack offsets and weights */
+        __m256i offset = _mm256_add_epi32( _mm256_mullo_epi32( y0, stride ), x0 );
+        __m256i weight = _mm256_or_si256( wx, _mm256_slli_epi32( wy, 16 ) );
+
+        /* Interleave and store entries */
+        __m256i lo = _mm256_unpacklo_epi32( offset, weight );
+        __m256i hi = _mm256_unpackhi_epi32( offset, weight );
+        _mm256_storeu_si256( (__m256i*) ( entries + i ), _mm256_permute2x128_si256( lo, hi, 0x20 ) );
+        _mm256_storeu_si256( (__m256i*) ( entries + i + 4 ), _mm256_permute2x128_si256( lo, hi, 0x31 ) );
+    }
+
+    /* Process remaining pixels */
+    if( i < count )
+        etg_coords_scalar( frame, y, x + i, count - i, entries + i );
+}
+
+/* Function to interpolate destination pixels from remap entries (AVX2) */
+__attribute__((target("avx2")))
+static void etg_gather_avx2(const quint32* s_bits,
+                            int s_stride,
+                            const remap_entry_struct* entries,
+                            int count,
+                            quint32* line)
+{
+    /* Constants */
+    const __m256i deinterleave = _mm256_setr_epi32( 0, 2, 4, 6, 1, 3, 5, 7 );
+    const __m256i low = _mm256_set1_epi32( 0x0000FFFF );
+    const __m256i unit = _mm256_set1_epi16( 256 );
+    const __m256i right = _mm256_set1_epi32( 1 );
+    const __m256i below = _mm256_set1_epi32( s_stride );
+    const __m256i below_right = _mm256_set1_epi32( s_stride + 1 );
+    const __m256i opaque = _mm256_set1_epi32( (int) 0xFF000000 );
+    const int* base = (const int*) s_bits;
+
+    /* Iterate over entries, 8 pixels at a time */
+    int i = 0;
+    for( ; i + 8 <= count; i += 8 )
+    {
+        /* Load and de-interleave entries */
+        __m256i e0 = _mm256_permutevar8x32_epi32( _mm256_loadu_si256( (const __m256i*) ( entries + i ) ), deinterleave );
+        __m256i e1 = _mm256_permutevar8x32_epi32( _mm256_loadu_si256( (const __m256i*) ( entries + i + 4 ) ), deinterleave );
+        __m256i offset = _mm256_permute2x128_si256( e0, e1, 0x20 );
+        __m256i weight = _mm256_permute2x128_si256( e0, e1, 0x31 );
+
+        /* Broadcast weights on both 16 bits halves */
+        __m256i wx = _mm256_and_si256( weight, low );
+        __m256i wy = _mm256_srli_epi32( weight, 16 );
+        wx = _mm256_or_si256( wx, _mm256_slli_epi32( wx, 16 ) );
+        wy = _mm256_or_si256( wy, _mm256_slli_epi32( wy, 16 ) );
+
+        /* Gather neighbours */
+        __m256i p00 = _mm256_i32gather_epi32( base, offset, 4 );
+        __m256i p01 = _mm256_i32gather_epi32( base, _mm256_add_epi32( offset, right ), 4 );
+        __m256i p10 = _mm256_i32gather_epi32( base, _mm256_add_epi32( offset, below ), 4 );
+        __m256i p11 = _mm256_i32gather_epi32( base, _mm256_add_epi32( offset, below_right ), 4 );
+
+        /* Interpolate rows */
+        __m256i iwx = _mm256_sub_epi16( unit, wx );
+        __m256i top = etg_blend_avx2( p00, p01, wx, iwx );
+        __m256i bottom = etg_blend_avx2( p10, p11, wx, iwx );
+
+        /* Interpolate columns and store opaque pixels */
+        __m256i result = etg_blend_avx2( top, bottom, wy, _mm256_sub_epi16( unit, wy ) );
+        _mm256_storeu_si256( (__m256i*) ( line + i ), _mm256_or_si256( result, opaque ) );
+    }
+
+    /* Process remaining pixels */
+    if( i < count )
+        etg_gather_scalar( s_bits, s_stride, entries + i, count - i, line + i );
+}
+
+/* Function to approximate arc-tangent of y / x on 4 lanes (SSE4.1) */
+__attribute__((target("sse4.1")))
+static inline __m128 etg_atan2_sse4(__m128 y, __m128 x)
+{
+    /* Constants */
+    const __m128 sign = _mm_set1_ps( -0.0f );
+    const __m128 tiny = _mm_set1_ps( 1e-30f );
+    const __m128 half_pi = _mm_set1_ps( (float) ( LG_PI / 2.0 ) );
+    const __m128 pi = _mm_set1_ps( (float) LG_PI );
+
+    /* Reduce ratio to [0, 1] */
+    __m128 ax = _mm_andnot_ps( sign, x );
+    __m128 ay = _mm_andnot_ps( sign, y );
+    __m128 a = _mm_div_ps( _mm_min_ps( ax, ay ), _mm_max_ps( _mm_max_ps( ax, ay ), tiny ) );
+    __m128 s = _mm_mul_ps( a, a );
+
+    /* Evaluate polynomial */
+    __m128 r = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( ETG_ATAN_C5 ), s ), _mm_set1_ps( ETG_ATAN_C4 ) );
+    r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( ETG_ATAN_C3 ) );
+    r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( ETG_ATAN_C2 ) );
+    r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( ETG_ATAN_C1 ) );
+    r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( ETG_ATAN_C0 ) );
+    r = _mm_mul_ps( r, a );
+
+    /* Restore octant and quadrant */
+    r = _mm_blendv_ps( r, _mm_sub_ps( half_pi, r ), _mm_cmpgt_ps( ay, ax ) );
+    r = _mm_blendv_ps( r, _mm_sub_ps( pi, r ), _mm_cmplt_ps( x, _mm_setzero_ps() ) );
+
+    /* Apply sign of y and return result */
+    return _mm_xor_ps( r, _mm_and_ps( y, sign ) );
+}
+
+/* Function to blend two ARGB32 pixels vectors with 0 - 256 weights (SSE4.1) */
+__attribute__((target("sse4.1")))
+static inline __m128i etg_blend_sse4(__m128i a, __m128i b, __m128i weight, __m128i inverse)
+{
+    /* Channels mask */
+    const __m128i mask = _mm_set1_epi32( 0x00FF00FF );
+
+    /* Blend red and blue channels */
+    __m128i rb = _mm_add_epi16( _mm_mullo_epi16( _mm_and_si128( a, mask ), inverse ),
+                                _mm_mullo_epi16( _mm_and_si128( b, mask ), weight ) );
+
+    /* Blend alpha and green channels */
+    __m128i ag = _mm_add_epi16( _mm_mullo_epi16( _mm_and_si128( _mm_srli_epi32( a, 8 ), mask ), inverse ),
+                                _mm_mullo_epi16( _mm_and_si128( _mm_srli_epi32( b, 8 ), mask ), weight ) );
+
+    /* Return result */
+    return _mm_or_si128( _mm_srli_epi16( rb, 8 ), _mm_andnot_si128( mask, ag ) );
+}
+
+/* Function to load 4 source pixels at given offsets (SSE4.1) */
+__attribute__((target("sse4.1")))
+static inline __m128i etg_load_sse4(const quint32* s_bits, __m128i offset)
+{
+    /* Return pixels */
+    return _mm_setr_epi32( (int) s_bits[ _mm_cvtsi128_si32( offset ) ],
+                           (int) s_bits[ _mm_extract_epi32( offset, 1 ) ],
+                           (int) s_bits[ _mm_extract_epi32( offset, 2 ) ],
+                           (int) s_bits[ _mm_extract_epi32( offset, 3 ) ] );
+}
+
+/* Function to compute remap entries of a destination row segment (SSE4.1) */
+__attribute__((target("sse4.1")))
+static void etg_coords_sse4(const etg_frame_struct* frame,
+                            int y,
+                            int x,
+                            int count,
+                            remap_entry_struct* entries)
+{
+    /* Compute row positions in rectilinear frame */
+    double pi1 = - frame->center_x * frame->pixel_x;
+    double pi2 = ( y - frame->center_y ) * frame->pixel_y;
+
+    /* Rotated position of first pixel and increment per pixel */
+    __m128 base0 = _mm_set1_ps( (float) ( frame->m[0][0] + frame->m[0][1] * pi1 + frame->m[0][2] * pi2 ) );
+    __m128 base1 = _mm_set1_ps( (float) ( frame->m[1][0] + frame->m[1][1] * pi1 + frame->m[1][2] * pi2 ) );
+    __m128 base2 = _mm_set1_ps( (float) ( frame->m[2][0] + frame->m[2][1] * pi1 + frame->m[2][2] * pi2 ) );
+    __m128 step0 = _mm_set1_ps( (float) ( frame->m[0][1] * frame->pixel_x ) );
+    __m128 step1 = _mm_set1_ps( (float) ( frame->m[1][1] * frame->pixel_x ) );
+    __m128 step2 = _mm_set1_ps( (float) ( frame->m[2][1] * frame->pixel_x ) );
+
+    /* Equirectangular mapping constants */
+    const __m128 scale_x = _mm_set1_ps( (float) ( ( frame->s_width - 1 ) / LG_PI2 ) );
+    const __m128 scale_y = _mm_set1_ps( (float) ( ( frame->s_height - 1 ) / LG_PI ) );
+    const __m128 shift_y = _mm_set1_ps( (float) ( ( frame->s_height - 1 ) / 2.0 ) );
+    const __m128 two_pi = _mm_set1_ps( (float) LG_PI2 );
+    const __m128 lanes = _mm_setr_ps( 0.0f, 1.0f, 2.0f, 3.0f );
+
+    /* Integer constants */
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max_x = _mm_set1_epi32( frame->s_width - 2 );
+    const __m128i max_y = _mm_set1_epi32( frame->s_height - 2 );
+    const __m128i max_w = _mm_set1_epi32( 256 );
+    const __m128i stride = _mm_set1_epi32( frame->s_stride );
+    const __m128 unit = _mm_set1_ps( 256.0f );
+    const __m128 round = _mm_set1_ps( 0.5f );
+
+    /* Iterate over row segment, 4 pixels at a time */
+    int i = 0;
+    for( ; i + 4 <= count; i += 4 )
+    {
+        /* Compute rotated positions */
+        __m128 px = _mm_add_ps( _mm_set1_ps( (float) ( x + i ) ), lanes );
+        __m128 p0 = _mm_add_ps( _mm_mul_ps( px, step0 ), base0 );
+        __m128 p1 = _mm_add_ps( _mm_mul_ps( px, step1 ), base1 );
+        __m128 p2 = _mm_add_ps( _mm_mul_ps( px, step2 ), base2 );
+
+        /* Compute spherical angles (asin computed as atan2 against horizontal norm) */
+        __m128 s_x = etg_atan2_sse4( p1, p0 );
+        __m128 s_y = etg_atan2_sse4( p2, _mm_sqrt_ps( _mm_add_ps( _mm_mul_ps( p0, p0 ), _mm_mul_ps( p1, p1 ) ) ) );
+
+        /* Wrap azimuth angle */
+        s_x = _mm_add_ps( s_x, _mm_and_ps( _mm_cmplt_ps( s_x, _mm_setzero_ps() ), two_pi ) );
+
+        /* Compute position in equirectangular image */
+        __m128 e_x = _mm_mul_ps( s_x, scale_x );
+        __m128 e_y = _mm_add_ps( _mm_mul_ps( s_y, scale_y ), shift_y );
+
+        /* Compute top-left neighbours */
+        __m128i x0 = _mm_min_epi32( _mm_max_epi32( _mm_cvttps_epi32( e_x ), zero ), max_x );
+        __m128i y0 = _mm_min_epi32( _mm_max_epi32( _mm_cvttps_epi32( e_y ), zero ), max_y );
+
+        /* Compute weights */
+        __m128i wx = _mm_cvttps_epi32( _mm_add_ps( _mm_mul_ps( _mm_sub_ps( e_x, _mm_cvtepi32_ps( x0 ) ), unit ), round ) );
+        __m128i wy = _mm_cvttps_epi32( _mm_add_ps( _mm_mul_ps( _mm_sub_ps( e_y, _mm_cvtepi32_ps( y0 ) ), unit ), round ) );
+        wx = _mm_min_epi32( _mm_max_epi32( wx, zero ), max_w );
+        wy = _mm_min_epi32( _mm_max_epi32( wy, zero ), max_w );
+
+        /* Pack offsets and weights */
+        __m128i offset = _mm_add_epi32( _mm_mullo_epi32( y0, stride ), x0 );
+        __m128i weight = _mm_or_si128( wx, _mm_slli_epi32( wy, 16 ) );
+
+        /* Interleave and store entries */
+        _mm_storeu_si128( (__m128i*) ( entries + i ), _mm_unpacklo_epi32( offset, weight ) );
+        _mm_storeu_si128( (__m128i*) ( entries + i + 2 ), _mm_unpackhi_epi32( offset, weight ) );
+    }
+
+    /* Process remaining pixels */
+    if( i < count )
+        etg_coords_scalar( frame, y, x + i, count - i, entries + i );
+}
+
+/* Function to interpolate destination pixels from remap entries (SSE4.1) */
+__attribute__((target("sse4.1")))
+static void etg_gather_sse4(const quint32* s_bits,
+                            int s_stride,
+                            const remap_entry_struct* entries,
+                            int count,
+                            quint32* line)
+{
+    /* Constants */
+    const __m128i low = _mm_set1_epi32( 0x0000FFFF );
+    const __m128i unit = _mm_set1_epi16( 256 );
+    const __m128i right = _mm_set1_epi32( 1 );
+    const __m128i below = _mm_set1_epi32( s_stride );
+    const __m128i below_right = _mm_set1_epi32( s_stride + 1 );
+    const __m128i opaque = _mm_set1_epi32( (int) 0xFF000000 );
+
+    /* Iterate over entries, 4 pixels at a time */
+    int i = 0;
+    for( ; i + 4 <= count; i += 4 )
+    {
+        /* Load and de-interleave entries */
+        __m128 e0 = _mm_castsi128_ps( _mm_loadu_si128( (const __m128i*) ( entries + i ) ) );
+        __m128 e1 = _mm_castsi128_ps( _mm_loadu_si128( (const __m128i*) ( entries + i + 2 ) ) );
+        __m128i offset = _mm_castps_si128( _mm_shuffle_ps( e0, e1, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+        __m128i weight = _mm_castps_si128( _mm_shuffle_ps( e0, e1, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+
+        /* Broadcast weights on both 16 bits halves */
+        __m128i wx = _mm_and_si128( weight, low );
+        __m128i wy = _mm_srli_epi32( weight, 16 );
+        wx = _mm_or_si128( wx, _mm_slli_epi32( wx, 16 ) );
+        wy = _mm_or_si128( wy, _mm_slli_epi32( wy, 16 ) );
+
+        /* Load neighbours */
+        __m128i p00 = etg_load_sse4( s_bits, offset );
+        __m128i p01 = etg_load_sse4( s_bits, _mm_add_epi32( offset, right ) );
+        __m128i p10 = etg_load_sse4( s_bits, _mm_add_epi32( offset, below ) );
+        __m128i p11 = etg_load_sse4( s_bits, _mm_add_epi32( offset, below_right ) );
+
+        /* Interpolate rows */
+        __m128i iwx = _mm_sub_epi16( unit, wx );
+        __m128i top = etg_blend_sse4( p00, p01, wx, iwx );
+        __m128i bottom = etg_blend_sse4( p10, p11, wx, iwx );
+
+        /* Interpolate columns and store opaque pixels */
+        __m128i result = etg_blend_sse4( top, bottom, wy, _mm_sub_epi16( unit, wy ) );
+        _mm_storeu_si128( (__m128i*) ( line + i ), _mm_or_si128( result, opaque ) );
+    }
+
+    /* Process remaining pixels */
+    if( i < count )
+        etg_gather_scalar( s_bits, s_stride, entries + i, count - i, line + i );
+}
+
+#endif // ETG_KERNEL_SIMD
+
+/* Function to detect best kernel supported by current CPU */
+static int etg_kernel_detect()
+{
+#ifdef ETG_KERNEL_SIMD
+
+    /* Initialize CPU features detection */
+    __builtin_cpu_init();
+
+    /* AVX2 kernel (uses FMA too) */
+    if( __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "fma" ) )
+        return EtgKernel::AVX2;
+
+    /* SSE4.1 kernel */
+    if( __builtin_cpu_supports( "sse4.1" ) )
+        return EtgKernel::SSE4;
+
+#endif
+
+    /* Generic kernel */
+    return EtgKernel::Scalar;
+}
+
+/* Function to get the kernel selected for current CPU */
+int etg_kernel_type()
+{
+    /* Detect kernel once */
+    static const int type = etg_kernel_detect();
+
+    /* Return result */
+    return type;
+}
+
+/* Function to compute projection frame of a gnomonic view */
+void etg_kernel_frame(etg_frame_struct* frame,
+                      const QImage* source,
+                      int width,
+                      int height,
+                      float azimuth,
+                      float elevation,
+                      float aperture)
+{
+    /* Create rotation matrix */
+    lg_algebra_r2erotation( frame->m, azimuth, elevation, 0 );
+
+    /* Compute pixel size (square pixels) */
+    frame->pixel_x = 2.0 * tan( aperture / 2.0 ) / width;
+    frame->pixel_y = frame->pixel_x;
+
+    /* Compute rectilinear image center */
+    frame->center_x = width / 2.0;
+    frame->center_y = height / 2.0;
+
+    /* Assign source image dimensions */
+    frame->s_width = source->width();
+    frame->s_height = source->height();
+    frame->s_stride = source->bytesPerLine() / 4;
+}
+
+/* Function to compute remap entries of a destination row segment */
+void etg_kernel_coords(const etg_frame_struct* frame,
+                       int y,
+                       int x,
+                       int count,
+                       remap_entry_struct* entries)
+{
+    /* Kernel switch */
+    switch( etg_kernel_type() )
+    {
+#ifdef ETG_KERNEL_SIMD
+    case EtgKernel::AVX2:
+        etg_coords_avx2( frame, y, x, count, entries );
+        break;
+    case EtgKernel::SSE4:
+        etg_coords_sse4( frame, y, x, count, entries );
+        break;
+#endif
+    default:
+        etg_coords_scalar( frame, y, x, count, entries );
+        break;
+    }
+}
+
+/* Function to interpolate destination pixels from remap entries */
+void etg_kernel_gather(const quint32* s_bits,
+                       int s_stride,
+                       const remap_entry_struct* entries,
+                       int count,
+                       quint32* line)
+{
+    /* Kernel switch */
+    switch( etg_kernel_type() )
+    {
+#ifdef ETG_KERNEL_SIMD
+    case EtgKernel::AVX2:
+        etg_gather_avx2( s_bits, s_stride, entries, count, line );
+        break;
+    case EtgKernel::SSE4:
+        etg_gather_sse4( s_bits, s_stride, entries, count, line );
+        break;
+#endif
+    default:
+        etg_gather_scalar( s_bits, s_stride, entries, count, line );
+        break;
+    }
+}
+
+/* Function to pick nearest destination pixels from remap entries */
+void etg_kernel_gather_nearest(const quint32* s_bits,
+                               int s_stride,
+                               const remap_entry_struct* entries,
+                               int count,
+                               quint32* line)
+{
+    /* Iterate over entries */
+    for( int i = 0; i < count; i++ )
+    {
+        /* Get top-left neighbour */
+        const quint32* p = s_bits + entries[i].offset;
+
+        /* Move to nearest neighbour (weights above half select next pixel) */
+        if( entries[i].weight_x >= 128 ) p += 1;
+        if( entries[i].weight_y >= 128 ) p += s_stride;
+
+        /* Assign opaque pixel */
+        line[i] = p[0] | 0xFF000000;
+    }
+}
+
+/* Function to project dest pixels of a prepared frame */
+static void etg_project_frame(const etg_frame_struct* frame,
+                              const QImage* source,
+                              QImage* dest,
+                              int d_width,
+                              int d_height,
+                              int threads,
+                              int interpolation)
+{
+    /* Source and destination data */
+    const quint32* s_bits = (const quint32*) source->constBits();
+    uchar* d_bits = dest->bits();
+    int d_stride = dest->bytesPerLine();
+
+    /* Iterate over destination Y axis */
+    #pragma omp parallel for num_threads( threads ) schedule( static )
+    for( int y = 0; y < d_height; y++ )
+    {
+        /* Chunk entries */
+        remap_entry_struct entries[ETG_KERNEL_CHUNK];
+
+        /* Destination row */
+        quint32* line = (quint32*) ( d_bits + y * d_stride );
+
+        /* Iterate over row chunks */
+        for( int x = 0; x < d_width; x += ETG_KERNEL_CHUNK )
+        {
+            /* Chunk size */
+            int count = qMin( ETG_KERNEL_CHUNK, d_width - x );
+
+            /* Compute and interpolate chunk */
+            etg_kernel_coords( frame, y, x, count, entries );
+
+            /* Interpolate chunk pixels */
+            if( interpolation == EtgInterpolation::Nearest )
+                etg_kernel_gather_nearest( s_bits, frame->s_stride, entries, count, line + x );
+            else
+                etg_kernel_gather( s_bits, frame->s_stride, entries, count, line + x );
+        }
+    }
+}
+
+/* Function to project an equirectangular ARGB32 image into a gnomonic RGB32 image */
+void etg_kernel_project(const QImage* source,
+                        QImage* dest,
+                        float azimuth,
+                        float elevation,
+                        float aperture,
+                        int threads,
+                        int interpolation)
+{
+    /* Use libgnomonic generic kernel if CPU has no SIMD kernel (bilinear only) */
+    if( etg_kernel_type() == EtgKernel::Scalar )
+    {
+        /* Project gnomonic image */
+        lg_etg_apperturep(
+
+            ( inter_C8_t * ) source->bits(),
+            source->width(),
+            source->height(),
+            4,
+            ( inter_C8_t * ) dest->bits(),
+            dest->width(),
+            dest->height(),
+            4,
+            azimuth,
+            elevation,
+            0.0,
+            aperture,
+            li_bilinearf,
+            threads
+        );
+
+        return;
+    }
+
+    /* Compute projection frame of whole view */
+    etg_frame_struct frame;
+    etg_kernel_frame( &frame, source, dest->width(), dest->height(), azimuth, elevation, aperture );
+
+    /* Project whole view */
+    etg_project_frame( &frame, source, dest, dest->width(), dest->height(), threads, interpolation );
+}
+
+/* Function to project only a sub-rectangle of a gnomonic view into dest (dest size is rect size) */
+void etg_kernel_project_rect(const QImage* source,
+                             QImage* dest,
+                             int width,
+                             int height,
+                             const QRect &rect,
+                             float azimuth,
+                             float elevation,
+                             float aperture,
+                             int threads)
+{
+    /* Compute projection frame of whole view */
+    etg_frame_struct frame;
+    etg_kernel_frame( &frame, source, width, height, azimuth, elevation, aperture );
+
+    /* Move frame origin to rectangle top-left corner */
+    frame.center_x -= rect.x();
+    frame.center_y -= rect.y();
+
+    /* Project rectangle pixels */
+    etg_project_frame( &frame, source, dest, qMin( rect.width(), dest->width() ), qMin( rect.height(), dest->height() ), threads, EtgInterpolation::Bilinear );
+}
+
+/* Function to project a sub-rectangle of a gnomonic view resampled to whole dest */
+void etg_kernel_project_scaled(const QImage* source,
+                               QImage* dest,
+                               int width,
+                               int height,
+                               const QRectF &rect,
+                               float azimuth,
+                               float elevation,
+                               float aperture,
+                               int threads)
+{
+    /* Compute projection frame of whole view */
+    etg_frame_struct frame;
+    etg_kernel_frame( &frame, source, width, height, azimuth, elevation, aperture );
+
+    /* View pixels covered by one destination pixel */
+    double scale_x = rect.width() / dest->width();
+    double scale_y = rect.height() / dest->height();
+
+    /* Map destination pixel centers onto rectangle */
+    frame.center_x = ( frame.center_x - rect.x() + 0.5 ) / scale_x - 0.5;
+    frame.center_y = ( frame.center_y - rect.y() + 0.5 ) / scale_y - 0.5;
+
+    /* Scale pixel sizes */
+    frame.pixel_x *= scale_x;
+    frame.pixel_y *= scale_y;
+
+    /* Project destination pixels */
+    etg_project_frame( &frame, source, dest, dest->width(), dest->height(), threads, EtgInterpolation::Bilinear );
+}
+
+/* Function to shrink an RGB32 image by an integer factor (box filter) */
+void etg_kernel_downsample(const QImage* source,
+                           QImage* dest,
+                           int factor,
+                           int threads)
+{
+    /* Destination dimensions */
+    int d_width = qMin( dest->width(), source->width() / factor );
+    int d_height = qMin( dest->height(), source->height() / factor );
+
+    /* Rounded division by number of averaged pixels */
+    quint32 area = factor * factor;
+    quint32 round = area / 2;
+
+    /* Source and destination data (destination detached once, before threads write rows) */
+    const uchar* s_bits = source->constBits();
+    int s_stride = source->bytesPerLine();
+    uchar* d_bits = dest->bits();
+    int d_stride = dest->bytesPerLine();
+
+    /* Threads region */
+    #pragma omp parallel num_threads( threads )
+    {
+        /* Channel sums of destination row (one buffer per thread) */
+        QVector<quint32> sums( d_width * 3 );
+        quint32* sum = sums.data();
+
+        /* Iterate over destination Y axis */
+        #pragma omp for schedule( static )
+        for( int y = 0; y < d_height; y++ )
+        {
+            /* Reset sums */
+            sums.fill( 0 );
+
+            /* Accumulate source rows */
+            for( int k = 0; k < factor; k++ )
+            {
+                /* Source row */
+                const uchar* row = s_bits + (qint64) ( y * factor + k ) * s_stride;
+
+                /* Accumulate source blocks of each destination pixel */
+                for( int x = 0; x < d_width; x++ )
+                {
+                    /* First source pixel of block */
+                    const uchar* pixel = row + x * factor * 4;
+
+                    /* Accumulate block columns */
+                    for( int j = 0; j < factor; j++ )
+                    {
+                        sum[ x * 3 + 0 ] += pixel[ j * 4 + 0 ];
+                        sum[ x * 3 + 1 ] += pixel[ j * 4 + 1 ];
+                        sum[ x * 3 + 2 ] += pixel[ j * 4 + 2 ];
+                    }
+                }
+            }
+
+            /* Destination row */
+            quint32* line = (quint32*) ( d_bits + (qint64) y * d_stride );
+
+            /* Assign averaged opaque pixels */
+            for( int x = 0; x < d_width; x++ )
+            {
+                line[x] = 0xff000000u |
+                          ( ( ( sum[ x * 3 + 2 ] + round ) / area ) << 16 ) |
+                          ( ( ( sum[ x * 3 + 1 ] + round ) / area ) << 8 ) |
+                          ( ( sum[ x * 3 + 0 ] + round ) / area );
+            }
+        }
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "exportnamer.h"
+
+/* Constructor */
+ExportNamer::ExportNamer(QString extension)
+{
+    /* Assign values */
+    this->extension = extension;
+}
+
+/* Function to find the highest tile number already present in a directory */
+int ExportNamer::scanDirectory(QString path)
+{
+    /* Highest tile number */
+    int highest = 0;
+
+    /* Iterate over existing tiles (single directory read) */
+    foreach(const QString &name, QDir( path ).entryList( QStringList() << "*." + this->extension, QDir::Files ))
+    {
+        /* Parse tile number */
+        bool ok = false;
+        int id = QFileInfo( name ).completeBaseName().toInt( &ok );
+
+        /* Keep highest number */
+        if( ok && id > highest )
+            highest = id;
+    }
+
+    /* Return result */
+    return highest;
+}
+
+/* Function to allocate next free tile path in a directory (created if missing) */
+QString ExportNamer::allocate(QString path)
+{
+    /* First tile of this directory */
+    if( !this->next_ids.contains( path ) )
+    {
+        /* Create path if not exists */
+        if(!QDir( path ).exists())
+        {
+            QDir().mkpath( path );
+        }
+
+        /* Continue after existing tiles */
+        this->next_ids.insert( path, this->scanDirectory( path ) + 1 );
+    }
+
+    /* Reserve tile number */
+    int id = this->next_ids[path]++;
+
+    /* Return result */
+    return path + QString::number( id ) + "." + this->extension;
+}
@@ -0,0 +1,149 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "exportpipeline.h"
+
+/* Function to read a manifest of "<image path> <validated yml path>" lines */
+bool loadManifest(QString path, QVector<manifest_entry_struct>* entries)
+{
+    /* Manifest file */
+    QFile file( path );
+
+    /* Open manifest */
+    if( !file.open( QIODevice::ReadOnly | QIODevice::Text ) )
+        return false;
+
+    /* Line reader */
+    QTextStream stream( &file );
+
+    /* Read manifest lines */
+    while( !stream.atEnd() )
+    {
+        /* Read line */
+        QString line = stream.readLine().trimmed();
+
+        /* Skip empty lines and comments */
+        if( line.isEmpty() || line.startsWith( "#" ) )
+            continue;
+
+        /* Split on tabs when present (paths may contain spaces), on whitespace otherwise */
+        QStringList fields = line.contains( '\t' ) ?
+                    line.split( '\t', QString::SkipEmptyParts ) :
+                    line.split( QRegExp( "\\s+" ), QString::SkipEmptyParts );
+
+        /* Check line format */
+        if( fields.size() != 2 )
+        {
+            /* Info output */
+            std::cout << "Invalid manifest line: " << line.toStdString() << std::endl;
+
+            /* Return result */
+            return false;
+        }
+
+        /* Manifest entry */
+        manifest_entry_struct entry;
+        entry.image_path = fields[0].trimmed();
+        entry.yml_path = fields[1].trimmed();
+
+        /* Append entry */
+        entries->append( entry );
+    }
+
+    /* Return result */
+    return true;
+}
+
+/* Constructor */
+PanoramaDecoder::PanoramaDecoder(const QVector<manifest_entry_struct> &entries,
+                                 BoundedQueue<export_panorama_struct>* queue,
+                                 QSemaphore* slots)
+{
+    /* Assign values */
+    this->entries = entries;
+    this->queue = queue;
+    this->slots = slots;
+}
+
+/* Function to decode every panorama in manifest order (runs in decoder thread) */
+void PanoramaDecoder::run()
+{
+    /* YML Parser */
+    YMLParser yml_parser;
+
+    /* Iterate over manifest entries */
+    foreach(const manifest_entry_struct &entry, this->entries)
+    {
+        /* Wait until an in-flight panorama is released */
+        this->slots->acquire();
+
+        /* Decoded panorama */
+        export_panorama_struct panorama;
+        panorama.entry = entry;
+        panorama.valid = false;
+
+        /* Source image infos structure */
+        image_info_struct image_info;
+
+        /* Load image directly into its final buffer */
+        if( loadPanorama( entry.image_path, &image_info ) )
+        {
+            /* Hand image ownership over, slot is released with the last reference */
+            panorama.image = QSharedPointer<QImage>( image_info.image, PanoramaRelease( this->slots ) );
+
+            /* Load YML */
+            panorama.records = yml_parser.loadYML( entry.yml_path, YMLType::Validator );
+
+            /* Mark as valid */
+            panorama.valid = true;
+
+        } else {
+
+            /* Nothing is kept in memory */
+            this->slots->release();
+        }
+
+        /* Hand panorama over to exporter */
+        if( !this->queue->push( panorama ) )
+            break;
+    }
+
+    /* Signal end of manifest */
+    this->queue->close();
+}
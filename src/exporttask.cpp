@@ -0,0 +1,79 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "exporttask.h"
+#include "utils.h"
+
+/* Constructor */
+ExportTask::ExportTask(QSharedPointer<QImage> source,
+                       const ObjectRecord &record,
+                       QRect selection,
+                       float zoom_level,
+                       QSize size,
+                       QString destination,
+                       int threads,
+                       TileEncoder* encoder)
+{
+    /* Assign values */
+    this->source = source;
+    this->record = record;
+    this->selection = selection;
+    this->zoom_level = zoom_level;
+    this->size = size;
+    this->destination = destination;
+    this->threads = threads;
+    this->encoder = encoder;
+}
+
+/* Function to warp and crop the tile, then hand it to encoder (runs in pool thread) */
+void ExportTask::run()
+{
+    /* Tile to encode */
+    encode_job_struct job;
+    job.destination = this->destination;
+    job.record = this->record;
+    job.selection = this->selection;
+    job.zoom_level = this->zoom_level;
+
+    /* Project and crop object tile */
+    job.tile = renderTile( this->source.data(), this->record, this->selection, this->zoom_level, this->threads, this->size );
+
+    /* Hand tile over to encoder stage */
+    this->encoder->push( job );
+}
@@ -0,0 +1,75 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "frameitem.h"
+
+/* Constructor */
+FrameItem::FrameItem(QGraphicsItem* parent) : QGraphicsItem(parent)
+{
+}
+
+/* Function to replace shown frame (no copy, frame buffer is shared) */
+void FrameItem::setFrame(const QImage &frame)
+{
+    /* Notify scene of geometry change */
+    if( frame.size() != this->frame.size() )
+        this->prepareGeometryChange();
+
+    /* Assign frame */
+    this->frame = frame;
+
+    /* Schedule repaint */
+    this->update();
+}
+
+/* Function to get item bounding rect */
+QRectF FrameItem::boundingRect() const
+{
+    /* Return result */
+    return QRectF( this->frame.rect() );
+}
+
+/* Function to paint item */
+void FrameItem::paint(QPainter* painter,
+                      const QStyleOptionGraphicsItem*,
+                      QWidget*)
+{
+    /* Draw frame */
+    painter->drawImage( QPointF( 0.0, 0.0 ), this->frame );
+}
@@ -37,6 +37,7 @@
  */
 
 #include "g2g_point.h"
+#include "projectioncontext.h"
 
 /*! \brief Gnomonic to gnomonic coordinates converter
  *
@@ -83,51 +84,10 @@ int g2g_point(
 
 ) {
 
-    /* Matrix array */
-    static double m[3][3] = { { 0.0 } };
+    /* Reference / secondary views */
+    ProjectionContext r_view( r_width, r_height, r_azim, r_elev, r_appe );
+    ProjectionContext c_view( c_width, c_height, c_azim, c_elev, c_appe );
 
-    /* Position arrays */
-    static double pi[3] = { 0.0 };
-    static double pf[3] = { 0.0 };
-
-    /* Pixel sizes */
-    static double r_pixel = 0.0;
-    static double c_pixel = 0.0;
-
-    /* Compute pixel sizes */
-    r_pixel = 2.0 * tan( r_appe / 2.0 ) / r_width;
-    c_pixel = 2.0 * tan( c_appe / 2.0 ) / c_width;
-
-    /* Compute position in reference rectilinear frame */
-    pi[0] = + ( 1.0 );
-    pi[1] = + ( r_x - ( r_width  / 2.0 ) ) * r_pixel;
-    pi[2] = + ( r_y - ( r_height / 2.0 ) ) * r_pixel;
-
-    /* Create rotation matrix */
-    lg_algebra_r2erotation( m, r_azim, r_elev, 0 );
-
-    /* Apply rotation on position */
-    pf[0] = m[0][0] * pi[0] + m[0][1] * pi[1] + m[0][2] * pi[2];
-    pf[1] = m[1][0] * pi[0] + m[1][1] * pi[1] + m[1][2] * pi[2];
-    pf[2] = m[2][0] * pi[0] + m[2][1] * pi[1] + m[2][2] * pi[2];
-
-    /* Create rotation matrix */
-    lg_algebra_e2rrotation( m, c_azim, c_elev, 0 );
-
-    /* Apply rotation on position */
-    pi[0] = m[0][0] * pf[0] + m[0][1] * pf[1] + m[0][2] * pf[2];
-    pi[1] = m[1][0] * pf[0] + m[1][1] * pf[1] + m[1][2] * pf[2];
-    pi[2] = m[2][0] * pf[0] + m[2][1] * pf[1] + m[2][2] * pf[2];
-
-    /* Check if destination variables are specified */
-    if( c_x != NULL && c_y != NULL )
-    {
-        /* Compute coordinates in secondary rectilinear frame */
-        * c_x = + ( ( pi[1] / pi[0] ) / c_pixel ) + ( c_width  / 2.0 );
-        * c_y = + ( ( pi[2] / pi[0] ) / c_pixel ) + ( c_height / 2.0 );
-    }
-
-    /* Compute frist order visibility condition */
-    if ( pi[0] > 0 ) return( 1 );
-    else return( 0 );
+    /* Map point, compute frist order visibility condition */
+    return r_view.mapTo( c_view, r_x, r_y, c_x, c_y ) ? 1 : 0;
 }
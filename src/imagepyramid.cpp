@@ -0,0 +1,138 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "imagepyramid.h"
+
+/* Minimal width of a downsampled level */
+#define IMAGE_PYRAMID_MIN_WIDTH 512
+
+/* Constructor */
+ImagePyramid::ImagePyramid()
+{
+    /* Initialize source */
+    this->source = NULL;
+}
+
+/* Destructor */
+ImagePyramid::~ImagePyramid()
+{
+    /* Release levels */
+    this->clear();
+}
+
+/* Function to build levels of source image (source is not owned) */
+void ImagePyramid::build(const QImage* source, int threads)
+{
+    /* Release previous levels */
+    this->clear();
+
+    /* Assign source */
+    this->source = source;
+
+    /* Exit if source is not available */
+    if( this->source == NULL )
+        return;
+
+    /* Downsample until level gets too small or cannot be halved exactly */
+    const QImage* previous = this->source;
+    while( ( previous->width() % 2 ) == 0 &&
+           ( previous->height() % 2 ) == 0 &&
+           ( previous->width() / 2 ) >= IMAGE_PYRAMID_MIN_WIDTH )
+    {
+        /* Allocate level */
+        QImage* image = new QImage( previous->width() / 2, previous->height() / 2, QImage::Format_RGB32 );
+
+        /* Average 2x2 blocks of previous level */
+        etg_kernel_downsample( previous, image, 2, threads );
+
+        /* Append level */
+        this->images.append( image );
+        previous = image;
+    }
+}
+
+/* Function to release all levels */
+void ImagePyramid::clear()
+{
+    /* Release downsampled levels */
+    for( int i = 0; i < this->images.count(); i++ )
+        delete this->images[i];
+
+    /* Reset levels */
+    this->images.clear();
+    this->source = NULL;
+}
+
+/* Function to get number of levels (source included) */
+int ImagePyramid::levels() const
+{
+    /* Return result */
+    return ( this->source != NULL ) ? this->images.count() + 1 : 0;
+}
+
+/* Function to get image of a level (level 0 is source) */
+const QImage* ImagePyramid::level(int index) const
+{
+    /* Return result */
+    return ( index <= 0 ) ? this->source : this->images[ index - 1 ];
+}
+
+/* Function to select level whose texel density matches a destination frame */
+int ImagePyramid::select(int width, float aperture) const
+{
+    /* Exit if no downsampled level is available */
+    if( this->images.isEmpty() || width <= 0 )
+        return 0;
+
+    /* Source texels per radian */
+    double texels = this->source->width() / ( 2.0 * M_PI );
+
+    /* Destination pixels per radian (frame center) */
+    double pixels = width / ( 2.0 * tan( aperture / 2.0 ) );
+
+    /* Exit if source is not denser than destination (zoomed in) */
+    if( texels <= pixels * 2.0 )
+        return 0;
+
+    /* Coarsest level still at least as dense as destination */
+    int index = (int) floor( log2( texels / pixels ) );
+
+    /* Return result */
+    return qMin( index, this->images.count() );
+}
@@ -0,0 +1,80 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include "batchoptions.h"
+
+/* Program entry point (headless exporter / converter) */
+int main(int argc, char *argv[])
+{
+    /* Main application container (no display needed) */
+    QCoreApplication app(argc, argv);
+
+    /* Application version info */
+    QCoreApplication::setApplicationName("Yafdb-Validator-CLI");
+    QCoreApplication::setApplicationVersion("0.1");
+
+    /* Command line parser object */
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Yafdb-Validator headless exporter / converter");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    /* Register arguments (no validator mode) */
+    addBatchOptions(&parser, false);
+
+    /* Process given arguments */
+    parser.process(app);
+
+    /* Parse and check arguments */
+    batch_arguments_struct arguments;
+    if( !parseBatchOptions(parser, false, &arguments) )
+    {
+        /* Display help and exit with error */
+        parser.showHelp( 1 );
+    }
+
+    /* Run batch mode */
+    bool result = runBatchMode(arguments);
+
+    /* Return exit code (batch schedulers rely on it) */
+    return result ? 0 : 1;
+}
@@ -116,6 +116,10 @@ void MainWindow::initializeValidator(QString sourceImagePath, QString detectorYM
         threads_count // Number of threads
     );
 
+    /* Edits are journaled once objects are loaded */
+    this->journal_enabled = false;
+    this->journal_timer = NULL;
+
     /* Variables to store files presence */
     bool sourceImageFile_exists = false;
     bool detectorYMLFile_exists = false;
@@ -170,11 +174,15 @@ void MainWindow::initializeValidator(QString sourceImagePath, QString detectorYM
             if( destinationYMLFile_exists )
             {
                 /* Load validator YML */
-                QList<ObjectRect*> loaded_rects = parser.loadYML( this->options.destinationYMLPath, YMLType::Validator );
+                QVector<ObjectRecord> loaded_rects = parser.loadYML( this->options.destinationYMLPath, YMLType::Validator );
 
                 /* Iterate over loaded rects */
-                foreach(ObjectRect* rect, loaded_rects)
+                foreach(const ObjectRecord &record, loaded_rects)
                 {
+                    /* Create scene object from record */
+                    ObjectRect* rect = new ObjectRect( record );
+                    rect->setResizeEnabled( false );
+
                     /* Map rect to current scene */
                     rect->mapTo(this->pano->getScene()->width(),
                                 this->pano->getScene()->height(),
@@ -185,12 +193,6 @@ void MainWindow::initializeValidator(QString sourceImagePath, QString detectorYM
                     /* Append mapped rect to scene */
                     rect->setId( this->pano->rect_list_id_index++ );
 
-                    /* Assign childrens ID's */
-                    foreach(ObjectRect* child, rect->childrens)
-                    {
-                        child->setId( this->pano->rect_list_id_index++ );
-                    }
-
                     this->pano->rect_list.append( rect );
                     this->pano->getScene()->addItem( rect );
 
@@ -203,11 +205,15 @@ void MainWindow::initializeValidator(QString sourceImagePath, QString detectorYM
             } else {
 
                 /* Load detector YML */
-                QList<ObjectRect*> loaded_rects = parser.loadYML( this->options.detectorYMLPath, YMLType::Detector );
+                QVector<ObjectRecord> loaded_rects = parser.loadYML( this->options.detectorYMLPath, YMLType::Detector );
 
                 /* Iterate over loaded rects */
-                foreach(ObjectRect* rect, loaded_rects)
+                foreach(const ObjectRecord &record, loaded_rects)
                 {
+                    /* Create scene object from record */
+                    ObjectRect* rect = new ObjectRect( record );
+                    rect->setResizeEnabled( false );
+
                     /* Map rect to current scene */
                     rect->mapFromSpherical(this->pano->image_info.width,
                                            this->pano->image_info.height,
@@ -222,12 +228,6 @@ void MainWindow::initializeValidator(QString sourceImagePath, QString detectorYM
                     /* Append mapped rect to scene */
                     rect->setId( this->pano->rect_list_id_index++ );
 
-                    /* Assign childrens ID's */
-                    foreach(ObjectRect* child, rect->childrens)
-                    {
-                        child->setId( this->pano->rect_list_id_index++ );
-                    }
-
                     this->pano->rect_list.append( rect );
                     this->pano->getScene()->addItem( rect );
 
@@ -244,39 +244,58 @@ void MainWindow::initializeValidator(QString sourceImagePath, QString detectorYM
         /* Check if destination YML path is specified */
         if( this->options.destinationYMLPath.length() > 0 )
         {
+            /* Validator objects / ids containers */
+            QVector<ObjectRecord> loaded_rects;
+            QVector<int> loaded_ids;
+
             /* Check if destination YML file exists */
             if( destinationYMLFile_exists )
             {
                 /* Load validator YML */
-                QList<ObjectRect*> loaded_rects = parser.loadYML( this->options.destinationYMLPath, YMLType::Validator );
-
-                /* Iterate over loaded rects */
-                foreach(ObjectRect* rect, loaded_rects)
-                {
-
-                    /* Map rect to current scene */
-                    rect->mapTo(this->pano->getScene()->width(),
-                                this->pano->getScene()->height(),
-                                this->pano->azimuth(),
-                                this->pano->elevation(),
-                                this->pano->aperture());
+                loaded_rects = parser.loadYML( this->options.destinationYMLPath, YMLType::Validator );
+            }
 
-                    /* Append mapped rect to scene */
-                    rect->setId( this->pano->rect_list_id_index++ );
+            /* Replay edits journaled by an interrupted session */
+            int replayed = this->journal.replay( this->options.destinationYMLPath, &loaded_rects, &loaded_ids );
 
-                    /* Assign childrens ID's */
-                    foreach(ObjectRect* child, rect->childrens)
-                    {
-                        child->setId( this->pano->rect_list_id_index++ );
-                    }
+            /* Iterate over loaded rects */
+            for( int i = 0; i < loaded_rects.size(); i++ )
+            {
+                /* Create scene object from record */
+                ObjectRect* rect = new ObjectRect( loaded_rects[i] );
+                rect->setResizeEnabled( false );
+
+                /* Map rect to current scene */
+                rect->mapTo(this->pano->getScene()->width(),
+                            this->pano->getScene()->height(),
+                            this->pano->azimuth(),
+                            this->pano->elevation(),
+                            this->pano->aperture());
+
+                /* Append mapped rect to scene (keep journaled id) */
+                rect->setId( loaded_ids[i] );
+                this->pano->rect_list_id_index = qMax( this->pano->rect_list_id_index, loaded_ids[i] + 1 );
+
+                this->pano->rect_list.append( rect );
+                this->pano->getScene()->addItem( rect );
+
+                /* Check object visibility */
+                if( !this->pano->isObjectVisible( rect ) )
+                    rect->setVisible( false );
+            }
 
-                    this->pano->rect_list.append( rect );
-                    this->pano->getScene()->addItem( rect );
+            /* Collect objects as journaled */
+            QVector<int> ids;
+            QVector<ObjectRecord> records;
+            this->collectRecords( &ids, &records );
 
-                    /* Check object visibility */
-                    if( !this->pano->isObjectVisible( rect ) )
-                        rect->setVisible( false );
-                }
+            /* Fold recovered edits into YML, then journal this session (keep recovered journal if YML could not be written) */
+            if( replayed > 0 )
+            {
+                this->journal_enabled = this->journal.compact( this->options.destinationYMLPath, ids, records ) ||
+                                        this->journal.resume( this->options.destinationYMLPath, ids, records );
+            } else {
+                this->journal_enabled = this->journal.begin( this->options.destinationYMLPath, ids, records );
             }
 
         /* Destination YML path not specified */
@@ -304,6 +323,15 @@ void MainWindow::initializeValidator(QString sourceImagePath, QString detectorYM
     /* Bind ESC key to window close */
     new QShortcut(QKeySequence("Esc"), this, SLOT(onESC()));
 
+    /* Start journal timer (journal holds unsaved changes until saved on close) */
+    if( this->journal_enabled )
+    {
+        /* Journal changes not signaled by labels refresh (objects drawing, re-projection) */
+        this->journal_timer = new QTimer( this );
+        connect( this->journal_timer, SIGNAL(timeout()), this, SLOT(journalChanges()) );
+        this->journal_timer->start( 2000 );
+    }
+
     /* Initialize labels */
     emit refreshLabels();
 }
@@ -343,29 +371,29 @@ void MainWindow::refreshLabels()
         case ObjectType::Face:
 
             /* If automatic status is valid or automatic status is None */
-            if(rect->getAutomaticStatus() == "Valid" || rect->getAutomaticStatus() == "None")
+            if(rect->getAutomaticStatus() == ObjectAutomaticStatus::Valid || rect->getAutomaticStatus() == ObjectAutomaticStatus::None)
             {
                 /* Increment faces count */
                 facecount++;
             }
 
             /* If automatic status is valid or automatic status is None and manual status is not None */
-            if( (rect->getAutomaticStatus() == "Valid" || rect->getAutomaticStatus() == "None")
-                    && rect->getManualStatus() != "None")
+            if( (rect->getAutomaticStatus() == ObjectAutomaticStatus::Valid || rect->getAutomaticStatus() == ObjectAutomaticStatus::None)
+                    && rect->getManualStatus() != ObjectManualStatus::None)
             {
                 /* Increment validated faces count */
                 facesvalidated++;
             }
 
             /* If automatic status is pre-filtered */
-            if(rect->getAutomaticStatus() != "None" && rect->getAutomaticStatus() != "Valid")
+            if(rect->getAutomaticStatus() != ObjectAutomaticStatus::None && rect->getAutomaticStatus() != ObjectAutomaticStatus::Valid)
             {
                 /* Increment pre-filtered items count */
                 preinvalidatedcount++;
             }
 
             /* If automatic status is pre-filtered and manualy validated */
-            if(rect->getAutomaticStatus() != "None" && rect->getAutomaticStatus() != "Valid" && rect->getManualStatus() != "None")
+            if(rect->getAutomaticStatus() != ObjectAutomaticStatus::None && rect->getAutomaticStatus() != ObjectAutomaticStatus::Valid && rect->getManualStatus() != ObjectManualStatus::None)
             {
                 /* Increment pre-filtered (manualy validated) items count */
                 preinvalidatedvalidated++;
@@ -380,7 +408,7 @@ void MainWindow::refreshLabels()
             numberplatescount++;
 
             /* If object is manualy validated */
-            if(rect->getManualStatus() != "None")
+            if(rect->getManualStatus() != ObjectManualStatus::None)
             {
                 /* Increment NumberPlate (manualy validated) items count */
                 numberplatesvalidated++;
@@ -479,6 +507,51 @@ void MainWindow::refreshLabels()
     /* "ToBlur" */
     this->ui->toBlurLabel->setText("To blur: " + QString::number(toblurcount));
 
+    /* Labels are refreshed after every objects edit */
+    this->journalChanges();
+}
+
+/* Function to collect objects records and ids */
+void MainWindow::collectRecords(QVector<int>* ids, QVector<ObjectRecord>* records)
+{
+    /* Reserve containers */
+    ids->reserve( this->pano->rect_list.length() );
+    records->reserve( this->pano->rect_list.length() );
+
+    /* Iterate over PanoramaViewer rects */
+    foreach(ObjectRect* rect, this->pano->rect_list)
+    {
+        ids->append( rect->getId() );
+        records->append( rect->toRecord() );
+    }
+}
+
+/* Function to stop journaling and delete journal */
+void MainWindow::closeJournal()
+{
+    /* Stop timer */
+    if( this->journal_timer )
+        this->journal_timer->stop();
+
+    /* Delete journal */
+    this->journal.discard();
+    this->journal_enabled = false;
+}
+
+/* (Journal action) Append objects changes to journal */
+void MainWindow::journalChanges()
+{
+    /* Check journal */
+    if( !this->journal_enabled )
+        return;
+
+    /* Collect current objects */
+    QVector<int> ids;
+    QVector<ObjectRecord> records;
+    this->collectRecords( &ids, &records );
+
+    /* Append changes */
+    this->journal.append( ids, records );
 }
 
 /* (UI action) Update scale factor slider */
@@ -488,6 +561,13 @@ void MainWindow::updateScaleSlider(int value)
     this->ui->horizontalSlider->setValue( value );
 }
 
+/* (UI action) Update render time label */
+void MainWindow::updateRenderTime(float time, float scale)
+{
+    /* Assign value */
+    this->ui->renderTimeLabel->setText( "Render time: " + QString::number( time, 'f', 1 ) + " ms (scale " + QString::number( scale, 'f', 2 ) + ")" );
+}
+
 /* Window close event */
 void MainWindow::closeEvent (QCloseEvent *event)
 {
@@ -511,8 +591,28 @@ void MainWindow::closeEvent (QCloseEvent *event)
             /* Initialize YMLparser */
             YMLParser parser;
 
-            /* Save YML */
-            parser.writeYML( this->pano->rect_list, this->options.destinationYMLPath );
+            /* Collect objects records */
+            QVector<ObjectRecord> records;
+            records.reserve( this->pano->rect_list.length() );
+            foreach(ObjectRect* rect, this->pano->rect_list)
+                records.append( rect->toRecord() );
+
+            /* Save YML (keep window and journal if it could not be written) */
+            if( !parser.writeYML( records, this->options.destinationYMLPath ) )
+            {
+                /* Journal latest changes */
+                this->journalChanges();
+
+                /* Warn user */
+                QMessageBox::warning( this, "Warning", "Unable to write " + this->options.destinationYMLPath + ", your work is kept in the journal." );
+
+                /* Ignore action */
+                event->ignore();
+                return;
+            }
+
+            /* Journal is saved in YML */
+            this->closeJournal();
 
             /* Accept event */
             event->accept();
@@ -520,6 +620,9 @@ void MainWindow::closeEvent (QCloseEvent *event)
         /* No */
         } else if(resBtn == QMessageBox::No) {
 
+            /* Discard journaled changes */
+            this->closeJournal();
+
             /* Accept event */
             event->accept();
         }
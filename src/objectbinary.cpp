@@ -0,0 +1,374 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "objectbinary.h"
+
+/* String table builder (deduplicated NUL terminated UTF-8 strings) */
+struct object_binary_strings_struct{
+
+    /* Table content / offsets of already stored strings */
+    QByteArray table;
+    QHash<QString, quint32> offsets;
+
+    /* Function to store a string, returns its offset */
+    quint32 add(const QString &value)
+    {
+        /* Reuse already stored string */
+        QHash<QString, quint32>::const_iterator it = this->offsets.constFind( value );
+        if( it != this->offsets.constEnd() )
+            return it.value();
+
+        /* Append string and terminator */
+        quint32 offset = this->table.size();
+        this->table.append( value.toUtf8() );
+        this->table.append( '\0' );
+
+        /* Remember offset */
+        this->offsets.insert( value, offset );
+        return offset;
+    }
+};
+
+/* Function to flatten an object and its childrens (depth first) */
+static void flatten(const ObjectRecord &object,
+                    object_binary_strings_struct* strings,
+                    QVector<object_binary_record_struct>* records)
+{
+    /* Record container */
+    object_binary_record_struct record;
+    memset( &record, 0, sizeof( record ) );
+
+    /* Object infos */
+    record.type = object.type;
+    record.sub_type = object.sub_type;
+    record.automatic_state = object.automatic_state;
+    record.manual_state = object.manual_state;
+    record.blurred = object.blurred ? 1 : 0;
+    record.automatic_status = object.automatic_status;
+    record.manual_status = object.manual_status;
+
+    /* Direct childrens count */
+    record.childrens = object.childrens.size();
+
+    /* Projection parameters */
+    record.azimuth = object.azimuth;
+    record.elevation = object.elevation;
+    record.aperture = object.aperture;
+    record.width = object.width;
+    record.height = object.height;
+
+    /* Source image path */
+    record.source_image = strings->add( object.source_image );
+
+    /* Projection points */
+    for( int i = 0; i < 4; i++ )
+    {
+        record.points[i * 2] = object.points[i].x();
+        record.points[i * 2 + 1] = object.points[i].y();
+    }
+
+    /* Append record */
+    records->append( record );
+
+    /* Append childrens right after their parent */
+    foreach( const ObjectRecord &child, object.childrens )
+        flatten( child, strings, records );
+}
+
+/* Constructor */
+ObjectBinaryFile::ObjectBinaryFile()
+{
+    /* Nothing mapped */
+    this->data = NULL;
+    this->size = 0;
+    this->header = NULL;
+}
+
+/* Destructor */
+ObjectBinaryFile::~ObjectBinaryFile()
+{
+    /* Unmap file */
+    this->close();
+}
+
+/* Function to map a binary objects file, false if missing or invalid */
+bool ObjectBinaryFile::open(QString path)
+{
+    /* Release previous mapping */
+    this->close();
+
+    /* Open file */
+    this->file.setFileName( path );
+    if( !this->file.open( QIODevice::ReadOnly ) )
+        return false;
+
+    /* Check header size */
+    this->size = this->file.size();
+    if( this->size < (qint64) sizeof( object_binary_header_struct ) )
+    {
+        this->close();
+        return false;
+    }
+
+    /* Map whole file */
+    this->data = this->file.map( 0, this->size );
+    if( !this->data )
+    {
+        this->close();
+        return false;
+    }
+
+    /* Header view */
+    const object_binary_header_struct* header = (const object_binary_header_struct*) this->data;
+
+    /* Check file identification */
+    bool valid = ( memcmp( header->magic, OBJECT_BINARY_MAGIC, 4 ) == 0 ) &&
+                 ( header->version == OBJECT_BINARY_VERSION ) &&
+                 ( header->byte_order == OBJECT_BINARY_BYTE_ORDER ) &&
+                 ( header->record_size == sizeof( object_binary_record_struct ) );
+
+    /* Check records bounds */
+    valid = valid && ( header->records_offset % sizeof( double ) == 0 ) &&
+                     ( header->records_offset + (quint64) header->count * header->record_size <= (quint64) this->size );
+
+    /* Check string table bounds (non-empty and terminated) */
+    valid = valid && ( header->strings_size > 0 ) &&
+                     ( header->strings_offset + header->strings_size <= (quint64) this->size ) &&
+                     ( this->data[header->strings_offset + header->strings_size - 1] == '\0' ) &&
+                     ( header->source_image < header->strings_size );
+
+    /* Drop invalid files */
+    if( !valid )
+    {
+        std::cout << "Invalid binary objects file: " << path.toStdString() << std::endl;
+        this->close();
+        return false;
+    }
+
+    /* Keep header view */
+    this->header = header;
+    return true;
+}
+
+/* Function to unmap file */
+void ObjectBinaryFile::close()
+{
+    /* Unmap data */
+    if( this->data )
+        this->file.unmap( (uchar*) this->data );
+
+    /* Close file */
+    if( this->file.isOpen() )
+        this->file.close();
+
+    /* Reset views */
+    this->data = NULL;
+    this->size = 0;
+    this->header = NULL;
+}
+
+/* Function to get number of records (childrens included) */
+int ObjectBinaryFile::count() const
+{
+    /* Return value */
+    return this->header ? this->header->count : 0;
+}
+
+/* Function to access a record in place */
+const object_binary_record_struct* ObjectBinaryFile::record(int index) const
+{
+    /* Return value */
+    return (const object_binary_record_struct*) ( this->data + this->header->records_offset ) + index;
+}
+
+/* Function to get a string of the string table */
+QString ObjectBinaryFile::string(quint32 offset) const
+{
+    /* Out of table strings are empty */
+    if( !this->header || offset >= this->header->strings_size )
+        return QString();
+
+    /* Return value (table is NUL terminated) */
+    return QString::fromUtf8( (const char*) ( this->data + this->header->strings_offset + offset ) );
+}
+
+/* Function to get source image path */
+QString ObjectBinaryFile::sourceImage() const
+{
+    /* Return value */
+    return this->header ? this->string( this->header->source_image ) : QString();
+}
+
+/* Function to convert a record and its childrens, returns index of next sibling */
+int ObjectBinaryFile::readObject(int index, QHash<quint32, QString>* strings, ObjectRecord* object) const
+{
+    /* Mapped record */
+    const object_binary_record_struct* record = this->record( index++ );
+
+    /* Object infos */
+    object->type = record->type;
+    object->sub_type = record->sub_type;
+    object->automatic_state = record->automatic_state;
+    object->manual_state = record->manual_state;
+    object->blurred = ( record->blurred != 0 );
+    object->automatic_status = record->automatic_status;
+    object->manual_status = record->manual_status;
+
+    /* Projection parameters */
+    object->azimuth = record->azimuth;
+    object->elevation = record->elevation;
+    object->aperture = record->aperture;
+    object->width = record->width;
+    object->height = record->height;
+
+    /* Projection points */
+    for( int i = 0; i < 4; i++ )
+        object->points[i] = QPointF( record->points[i * 2], record->points[i * 2 + 1] );
+
+    /* Source image path (decoded once per string, then shared) */
+    QHash<quint32, QString>::iterator path = strings->find( record->source_image );
+    if( path == strings->end() )
+        path = strings->insert( record->source_image, this->string( record->source_image ) );
+    object->source_image = path.value();
+
+    /* Read childrens (stop on truncated trees) */
+    for( quint32 i = 0; i < record->childrens && index < this->count(); i++ )
+    {
+        ObjectRecord child;
+        index = this->readObject( index, strings, &child );
+        object->childrens.append( child );
+    }
+
+    /* Return next sibling index */
+    return index;
+}
+
+/* Function to convert mapped records into ObjectRecord list */
+QVector<ObjectRecord> ObjectBinaryFile::objects() const
+{
+    /* Objects container */
+    QVector<ObjectRecord> objects;
+
+    /* Decoded strings (source image paths are shared by most records) */
+    QHash<quint32, QString> strings;
+
+    /* Read top level objects */
+    int index = 0;
+    while( index < this->count() )
+    {
+        ObjectRecord object;
+        index = this->readObject( index, &strings, &object );
+        objects.append( object );
+    }
+
+    /* Return value */
+    return objects;
+}
+
+/* Function to check if file was written along given YML, as the YML is now */
+bool ObjectBinaryFile::matches(QString yml_path) const
+{
+    /* Check mapping */
+    if( !this->header )
+        return false;
+
+    /* YML file infos */
+    QFileInfo info( yml_path );
+
+    /* Compare exact size and modification time */
+    return info.exists() &&
+           this->header->yml_size == info.size() &&
+           this->header->yml_modified == info.lastModified().toMSecsSinceEpoch();
+}
+
+/* Function to write ObjectRecord list as binary objects file (yml_path: YML holding the same objects, if any) */
+bool ObjectBinaryFile::write(const QVector<ObjectRecord> &objects, QString path, QString yml_path)
+{
+    /* String table / records containers */
+    object_binary_strings_struct strings;
+    QVector<object_binary_record_struct> records;
+
+    /* Offset 0 is the empty string */
+    strings.add( QString() );
+
+    /* Flatten objects */
+    foreach( const ObjectRecord &object, objects )
+        flatten( object, &strings, &records );
+
+    /* Header */
+    object_binary_header_struct header;
+    memset( &header, 0, sizeof( header ) );
+    memcpy( header.magic, OBJECT_BINARY_MAGIC, 4 );
+    header.version = OBJECT_BINARY_VERSION;
+    header.byte_order = OBJECT_BINARY_BYTE_ORDER;
+    header.record_size = sizeof( object_binary_record_struct );
+    header.count = records.size();
+    header.source_image = strings.add( objects.isEmpty() ? QString() : objects.first().source_image );
+    header.records_offset = sizeof( object_binary_header_struct );
+    header.strings_offset = header.records_offset + (quint64) records.size() * sizeof( object_binary_record_struct );
+    header.strings_size = strings.table.size();
+
+    /* YML written along */
+    QFileInfo yml_info( yml_path );
+    header.yml_size = ( yml_path.length() > 0 && yml_info.exists() ) ? yml_info.size() : -1;
+    header.yml_modified = ( yml_path.length() > 0 && yml_info.exists() ) ? yml_info.lastModified().toMSecsSinceEpoch() : 0;
+
+    /* Write to a temporary file, destination is replaced on commit (never missing) */
+    QSaveFile file( path );
+    if( !file.open( QIODevice::WriteOnly ) )
+    {
+        std::cout << "Unable to write binary objects file: " << path.toStdString() << std::endl;
+        return false;
+    }
+
+    /* Write header, records and string table */
+    bool written = ( file.write( (const char*) &header, sizeof( header ) ) == (qint64) sizeof( header ) ) &&
+                   ( file.write( (const char*) records.constData(), records.size() * sizeof( object_binary_record_struct ) ) == (qint64) ( records.size() * sizeof( object_binary_record_struct ) ) ) &&
+                   ( file.write( strings.table ) == strings.table.size() );
+
+    /* Check write result, replace destination */
+    if( !written || !file.commit() )
+    {
+        std::cout << "Unable to write binary objects file: " << path.toStdString() << std::endl;
+        return false;
+    }
+
+    /* Return result */
+    return true;
+}
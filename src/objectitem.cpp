@@ -55,8 +55,8 @@ ObjectItem::ObjectItem(QWidget *parent) :
     this->ui->imageLabel->setAlignment(Qt::AlignHCenter | Qt::AlignVCenter);
 
     /* Default values initialisation */
-    this->manualStatus = "None";
-    this->autoStatus = "None";
+    this->manualStatus = ObjectManualStatus::None;
+    this->autoStatus = ObjectAutomaticStatus::None;
     this->border_size = 4;
     this->needs_removal = false;
 
@@ -81,8 +81,8 @@ ObjectItem::ObjectItem(QWidget *parent, PanoramaViewer* pano, ObjectRect* rect)
     this->ui->imageLabel->setAlignment(Qt::AlignHCenter | Qt::AlignVCenter);
 
     /* Default values initialisation */
-    this->manualStatus = "None";
-    this->autoStatus = "None";
+    this->manualStatus = ObjectManualStatus::None;
+    this->autoStatus = ObjectAutomaticStatus::None;
     this->border_size = 4;
     this->needs_removal = false;
 
@@ -346,10 +346,10 @@ void ObjectItem::setParentRect(ObjectRect *src_rect)
     this->setAutomaticStatus( src_rect->getAutomaticStatus() );
 
     /* If object has an automatic status */
-    if(src_rect->getAutomaticStatus() != "None")
+    if(src_rect->getAutomaticStatus() != ObjectAutomaticStatus::None)
     {
         /* If automatic status is valid */
-        if(src_rect->getAutomaticStatus() == "Valid")
+        if(src_rect->getAutomaticStatus() == ObjectAutomaticStatus::Valid)
         {
             /* Set automatic state to valid */
             this->setItemAutomaticState(ObjectAutomaticState::Valid);
@@ -479,7 +479,7 @@ void ObjectItem::setItemAutomaticState(int state)
 }
 
 /* Function to set automatic status value */
-void ObjectItem::setAutomaticStatus(QString value)
+void ObjectItem::setAutomaticStatus(int value)
 {
     /* Assign value */
     this->autoStatus = value;
@@ -489,14 +489,14 @@ void ObjectItem::setAutomaticStatus(QString value)
 }
 
 /* Automatic status getter */
-QString ObjectItem::getAutomaticStatus()
+int ObjectItem::getAutomaticStatus()
 {
     /* Return value */
     return this->autoStatus;
 }
 
 /* Function to set manual status value */
-void ObjectItem::setManualStatus(QString value)
+void ObjectItem::setManualStatus(int value)
 {
     /* Assign value */
     this->manualStatus = value;
@@ -506,7 +506,7 @@ void ObjectItem::setManualStatus(QString value)
 }
 
 /* Manual status getter */
-QString ObjectItem::getManualStatus()
+int ObjectItem::getManualStatus()
 {
     /* Return value */
     return this->manualStatus;
@@ -0,0 +1,320 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "objectrecord.h"
+
+/* Constructor */
+ObjectRecord::ObjectRecord()
+{
+    /* Default informations */
+    this->type = ObjectType::None;
+    this->sub_type = ObjectSubType::None;
+    this->automatic_state = ObjectAutomaticState::Manual;
+    this->manual_state = ObjectManualState::None;
+    this->blurred = false;
+    this->automatic_status = ObjectAutomaticStatus::None;
+    this->manual_status = ObjectManualStatus::None;
+
+    /* Default projection parameters */
+    this->azimuth = 0.0;
+    this->elevation = 0.0;
+    this->aperture = 0.0;
+    this->width = 0.0;
+    this->height = 0.0;
+}
+
+/* Function to get object class name (as written in YML) */
+QString ObjectRecord::className() const
+{
+    /* Type switch */
+    switch(this->type)
+    {
+    case ObjectType::Face:
+        return "Face";
+    case ObjectType::NumberPlate:
+        return "NumberPlate";
+    case ObjectType::ToBlur:
+        return "ToBlur";
+    default:
+        return "None";
+    }
+}
+
+/* Function to get object sub-class name (as written in YML) */
+QString ObjectRecord::subClassName() const
+{
+    /* Sub-type switch */
+    switch(this->sub_type)
+    {
+    case ObjectSubType::Front:
+        return "Front";
+    case ObjectSubType::Profile:
+        return "Profile";
+    case ObjectSubType::Back:
+        return "Back";
+    case ObjectSubType::Top:
+        return "Top";
+    case ObjectSubType::Eyes:
+        return "Eyes";
+    default:
+        return "None";
+    }
+}
+
+/* Function to get automatic status name (as written in YML) */
+QString ObjectRecord::automaticStatusName() const
+{
+    /* Automatic status switch */
+    switch(this->automatic_status)
+    {
+    case ObjectAutomaticStatus::Valid:
+        return "Valid";
+    case ObjectAutomaticStatus::Ratio:
+        return "Ratio";
+    case ObjectAutomaticStatus::Size:
+        return "Size";
+    case ObjectAutomaticStatus::RatioSize:
+        return "Ratio-Size";
+    case ObjectAutomaticStatus::MissingOption:
+        return "MissingOption";
+    default:
+        return "None";
+    }
+}
+
+/* Function to get manual status name (as written in YML) */
+QString ObjectRecord::manualStatusName() const
+{
+    /* Manual status switch */
+    switch(this->manual_status)
+    {
+    case ObjectManualStatus::Valid:
+        return "Valid";
+    case ObjectManualStatus::Invalid:
+        return "Invalid";
+    default:
+        return "None";
+    }
+}
+
+/* Function to parse automatic status name (case insensitive), unknown names give None */
+int ObjectRecord::parseAutomaticStatus(QString name)
+{
+    /* Match names */
+    if( name.compare( QLatin1String( "valid" ), Qt::CaseInsensitive ) == 0 )
+        return ObjectAutomaticStatus::Valid;
+    if( name.compare( QLatin1String( "ratio" ), Qt::CaseInsensitive ) == 0 )
+        return ObjectAutomaticStatus::Ratio;
+    if( name.compare( QLatin1String( "size" ), Qt::CaseInsensitive ) == 0 )
+        return ObjectAutomaticStatus::Size;
+    if( name.compare( QLatin1String( "ratio-size" ), Qt::CaseInsensitive ) == 0 )
+        return ObjectAutomaticStatus::RatioSize;
+    if( name.compare( QLatin1String( "missingoption" ), Qt::CaseInsensitive ) == 0 )
+        return ObjectAutomaticStatus::MissingOption;
+
+    /* Return value */
+    return ObjectAutomaticStatus::None;
+}
+
+/* Function to parse manual status name (case insensitive), unknown names give Invalid */
+int ObjectRecord::parseManualStatus(QString name)
+{
+    /* Match names */
+    if( name.length() <= 0 || name.compare( QLatin1String( "none" ), Qt::CaseInsensitive ) == 0 )
+        return ObjectManualStatus::None;
+    if( name.compare( QLatin1String( "valid" ), Qt::CaseInsensitive ) == 0 )
+        return ObjectManualStatus::Valid;
+
+    /* Return value */
+    return ObjectManualStatus::Invalid;
+}
+
+/* Function to complete missing points (zero coordinate) of a rectangle */
+void ObjectRecord::completePoints(QPointF p1, QPointF p2, QPointF p3, QPointF p4, QPointF* points)
+{
+    /* Try to compute point 1 if not specified */
+    points[0] = ( p1.x() == 0 || p1.y() == 0 ) ? QPointF( p2.x(), p4.y() ) : p1;
+
+    /* Try to compute point 2 if not specified */
+    points[1] = ( p2.x() == 0 || p2.y() == 0 ) ? QPointF( p1.x(), p3.y() ) : p2;
+
+    /* Try to compute point 3 if not specified */
+    points[2] = ( p3.x() == 0 || p3.y() == 0 ) ? QPointF( p4.x(), p2.y() ) : p3;
+
+    /* Try to compute point 4 if not specified */
+    points[3] = ( p4.x() == 0 || p4.y() == 0 ) ? QPointF( p3.x(), p1.y() ) : p4;
+}
+
+/* Function to set projection points, missing points (zero coordinate) are computed from the others */
+void ObjectRecord::setPoints(QPointF p1, QPointF p2, QPointF p3, QPointF p4)
+{
+    /* Assign completed points */
+    ObjectRecord::completePoints( p1, p2, p3, p4, this->points );
+}
+
+/* Function to get object size in its projection */
+QSizeF ObjectRecord::getSize() const
+{
+    /* Return value */
+    return QSizeF( this->points[3].x() - this->points[0].x(),
+                   this->points[1].y() - this->points[0].y() );
+}
+
+/* Comparison operator (all fields, childrens included) */
+bool ObjectRecord::operator==(const ObjectRecord &other) const
+{
+    /* Compare points */
+    for( int i = 0; i < 4; i++ )
+    {
+        if( this->points[i] != other.points[i] )
+            return false;
+    }
+
+    /* Compare remaining fields */
+    return this->type == other.type &&
+           this->sub_type == other.sub_type &&
+           this->automatic_state == other.automatic_state &&
+           this->manual_state == other.manual_state &&
+           this->blurred == other.blurred &&
+           this->automatic_status == other.automatic_status &&
+           this->manual_status == other.manual_status &&
+           this->azimuth == other.azimuth &&
+           this->elevation == other.elevation &&
+           this->aperture == other.aperture &&
+           this->width == other.width &&
+           this->height == other.height &&
+           this->source_image == other.source_image &&
+           this->childrens == other.childrens;
+}
+
+/* Comparison operator (all fields, childrens included) */
+bool ObjectRecord::operator!=(const ObjectRecord &other) const
+{
+    /* Return value */
+    return !( *this == other );
+}
+
+/* Function to map projection points to specified projection paramaters */
+void ObjectRecord::mapTo(float width,
+                         float height,
+                         float azimuth,
+                         float elevation,
+                         float aperture,
+                         QPointF* mapped) const
+{
+    /* Object / destination views */
+    ProjectionContext source( this->width, this->height, this->azimuth, this->elevation, this->aperture );
+    ProjectionContext dest( width, height, azimuth, elevation, aperture );
+
+    /* Source / destination coordinates */
+    double x[4], y[4], mapped_x[4], mapped_y[4];
+    for( int i = 0; i < 4; i++ )
+    {
+        x[i] = this->points[i].x();
+        y[i] = this->points[i].y();
+    }
+
+    /* Map points */
+    source.mapTo( dest, 4, x, y, mapped_x, mapped_y );
+
+    /* Assign mapped points */
+    for( int i = 0; i < 4; i++ )
+        mapped[i] = QPointF( mapped_x[i], mapped_y[i] );
+}
+
+/* Function to convert spherical coordinates to gnomonic projection parameters / points */
+void ObjectRecord::mapFromSpherical(float source_width,
+                                    float source_height,
+                                    float dest_width,
+                                    float dest_height,
+                                    float dest_zoom_min,
+                                    float dest_zoom_max)
+{
+    /* Declare point containers */
+    QPointF p1, p3;
+
+    /* Denormalize point 1 */
+    double p1_d_x = ((this->points[0].x() / LG_PI2) * source_width);
+    double p1_d_y = (((this->points[0].y()) + ( LG_PI / 2.0 )) / LG_PI ) * source_height;
+
+    /* Denormalize point 2 */
+    double p3_d_x = ((this->points[2].x() / LG_PI2) * source_width);
+    double p3_d_y = (((this->points[2].y()) + ( LG_PI / 2.0 )) / LG_PI ) * source_height;
+
+    /* Determine width/height */
+    double width  = ( p3_d_x + p1_d_x );
+    double height = ( p3_d_y + p1_d_y );
+
+    /* Determine best aperture */
+    float aperture = ( ( ( p3_d_x - p1_d_x ) / source_width ) * 30.0 );
+
+    /* Clamp aperture */
+    aperture = aperture < dest_zoom_min ? dest_zoom_min : aperture;
+    aperture = aperture > dest_zoom_max ? dest_zoom_max : aperture;
+
+    /* Determine center */
+    double center_x = ( width / 2.0 );
+    double center_y = ( height / 2.0 );
+
+    /* Determine azimuth/elevation */
+    float azimuth = ( ( center_x / source_width ) * LG_PI2 );
+    float elevation = ( ( - ( center_y / source_height ) + 0.5 ) * LG_PI );
+
+    /* Destination view (shared by both points) */
+    ProjectionContext dest( dest_width, dest_height, azimuth, elevation, aperture );
+
+    /* Convert point 1 */
+    dest.fromEquirectangular( source_width, source_height, p1_d_x, p1_d_y, &p1.rx(), &p1.ry() );
+
+    /* Convert point 2 */
+    dest.fromEquirectangular( source_width, source_height, p3_d_x, p3_d_y, &p3.rx(), &p3.ry() );
+
+    /* Update projection points */
+    this->setPoints(p1,
+                    QPointF(0.0, 0.0),
+                    p3,
+                    QPointF(0.0, 0.0));
+
+    /* Update projection parameters */
+    this->azimuth = azimuth;
+    this->elevation = elevation;
+    this->aperture = aperture;
+    this->width = dest_width;
+    this->height = dest_height;
+}
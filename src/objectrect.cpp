@@ -38,6 +38,9 @@
 
 #include "objectrect.h"
 
+/* Objects geometry revision counter */
+int ObjectRect::geometry_revision = 0;
+
 /* Constructor */
 ObjectRect::ObjectRect()
 {
@@ -51,31 +54,13 @@ ObjectRect::ObjectRect()
     /* Default id */
     this->id = 0;
 
+    /* Not mapped yet */
+    this->in_view = false;
+
     /* Default pen setup */
     this->pen = new QPen(QColor(0, 255, 255, 255), 2);
     this->brush = new QBrush(QColor(0, 255, 0, 50), Qt::SolidPattern);
 
-    /* Default projection parameters */
-    this->projection_parameters.azimuth = 0.0;
-    this->projection_parameters.elevation = 0.0;
-    this->projection_parameters.aperture = 0.0;
-    this->projection_parameters.width = 0.0;
-    this->projection_parameters.height = 0.0;
-
-    /* Default projection points */
-    this->projection_parameters.points.append(QPointF(0.0, 0.0));
-    this->projection_parameters.points.append(QPointF(0.0, 0.0));
-    this->projection_parameters.points.append(QPointF(0.0, 0.0));
-    this->projection_parameters.points.append(QPointF(0.0, 0.0));
-
-    /* Default informations */
-    this->info.automatic_status = "None";
-    this->info.manual_status = "None";
-    this->info.blurred = false;
-    this->info.validated = false;
-    this->info.type = ObjectType::None;
-    this->info.sub_type = ObjectSubType::None;
-
     /* Default contour setup (First) */
     this->contour_pen = new QPen(QColor(255, 255, 255, 255), 2);
     this->contour = new QGraphicsPolygonItem( this );
@@ -98,6 +83,46 @@ ObjectRect::ObjectRect()
     this->render();
 }
 
+/* Constructor (view over a record) */
+ObjectRect::ObjectRect(const ObjectRecord &record) : ObjectRect()
+{
+    /* Restore tags/values (setters update colors) */
+    this->setObjectAutomaticState( record.automatic_state );
+    this->setObjectManualState( record.manual_state );
+    this->setObjectType( record.type );
+    this->setObjectSubType( record.sub_type );
+    this->setManualStatus( record.manual_status );
+    this->setAutomaticStatus( record.automatic_status );
+    this->setBlurred( record.blurred );
+    this->setSourceImagePath( record.source_image );
+
+    /* Restore projection parameters */
+    this->setProjectionParametters(record.azimuth,
+                                   record.elevation,
+                                   record.aperture,
+                                   record.width,
+                                   record.height);
+
+    /* Restore points */
+    this->setPoints(record.points[0],
+                    record.points[1],
+                    record.points[2],
+                    record.points[3]);
+
+    /* Set projection points */
+    this->setProjectionPoints();
+
+    /* Keep childrens records */
+    this->record.childrens = record.childrens;
+}
+
+/* Function to get object record */
+ObjectRecord ObjectRect::toRecord()
+{
+    /* Return result */
+    return this->record;
+}
+
 /* Function to set point 1 */
 void ObjectRect::setPoint1(QPointF point)
 {
@@ -189,38 +214,13 @@ void ObjectRect::setPoint4(QPointF point)
 /* Function to set all the points at the same time */
 void ObjectRect::setPoints(QPointF p1, QPointF p2, QPointF p3, QPointF p4)
 {
+    /* Compute missing points */
+    QPointF completed[4];
+    ObjectRecord::completePoints( p1, p2, p3, p4, completed );
 
-    /* Try to compute point 1 if not specified */
-    if( p1.x() == 0 || p1.y() == 0 )
-    {
-        this->setPoint1( QPointF( p2.x(), p4.y() ) );
-    } else {
-        this->setPoint1( p1 );
-    }
-
-    /* Try to compute point 2 if not specified */
-    if( p2.x() == 0 || p2.y() == 0 )
-    {
-        this->setPoint2( QPointF( p1.x(), p3.y() ) );
-    } else {
-        this->setPoint2( p2 );
-    }
-
-    /* Try to compute point 3 if not specified */
-    if( p3.x() == 0 || p3.y() == 0 )
-    {
-        this->setPoint3( QPointF( p4.x(), p2.y() ) );
-    } else {
-        this->setPoint3( p3 );
-    }
-
-    /* Try to compute point 4 if not specified */
-    if( p4.x() == 0 || p4.y() == 0 )
-    {
-        this->setPoint4( QPointF( p3.x(), p1.y() ) );
-    } else {
-        this->setPoint4( p4 );
-    }
+    /* Assign points */
+    for( int i = 0; i < 4; i++ )
+        this->points[i] = completed[i];
 
     /* Render object */
     this->render();
@@ -435,7 +435,7 @@ int ObjectRect::getId()
 void ObjectRect::setObjectAutomaticState(int state)
 {
     /* Assign value */
-    this->automatic_state = state;
+    this->record.automatic_state = state;
 
     /* Set proper color depending on rect type specified */
     switch(state)
@@ -460,13 +460,13 @@ void ObjectRect::setObjectAutomaticState(int state)
 int ObjectRect::getObjectAutomaticState()
 {
     /* Return result */
-    return this->automatic_state;
+    return this->record.automatic_state;
 }
 
 void ObjectRect::setObjectManualState(int state)
 {
     /* Assign value */
-    this->manual_state = state;
+    this->record.manual_state = state;
 
     /* Set proper color depending on state specified */
     switch(state)
@@ -493,7 +493,7 @@ void ObjectRect::setObjectManualState(int state)
 int ObjectRect::getObjectManualState()
 {
     /* Return result */
-    return this->manual_state;
+    return this->record.manual_state;
 }
 
 /* Function to (re)render object */
@@ -563,118 +563,128 @@ void ObjectRect::setProjectionParametters(float azimuth,
         float width,
         float height)
 {
-    this->projection_parameters.azimuth = azimuth;
-    this->projection_parameters.elevation = elevation;
-    this->projection_parameters.aperture = aperture;
-    this->projection_parameters.width = width;
-    this->projection_parameters.height = height;
+    this->record.azimuth = azimuth;
+    this->record.elevation = elevation;
+    this->record.aperture = aperture;
+    this->record.width = width;
+    this->record.height = height;
+
+    /* Geometry changed */
+    ObjectRect::geometry_revision++;
 }
 
 /* Function to set/update initial projection points based on current points */
 void ObjectRect::setProjectionPoints()
 {
     /* Assign value */
-    this->projection_parameters.points = this->points;
+    for( int i = 0; i < 4; i++ )
+        this->record.points[i] = this->points[i];
+
+    /* Geometry changed */
+    ObjectRect::geometry_revision++;
 }
 
 /* Function to set/update initial projection points */
 void ObjectRect::setProjectionPoints(QPointF p1, QPointF p2, QPointF p3, QPointF p4)
 {
-    this->projection_parameters.points[0] = p1;
-    this->projection_parameters.points[1] = p2;
-    this->projection_parameters.points[2] = p3;
-    this->projection_parameters.points[3] = p4;
+    this->record.points[0] = p1;
+    this->record.points[1] = p2;
+    this->record.points[2] = p3;
+    this->record.points[3] = p4;
+
+    /* Geometry changed */
+    ObjectRect::geometry_revision++;
 }
 
 /* Function to set source image path */
 void ObjectRect::setSourceImagePath(QString path)
 {
     /* Assign value */
-    this->projection_parameters.source_image = path;
+    this->record.source_image = path;
 }
 
 /* Function to get source image path */
 QString ObjectRect::getSourceImagePath()
 {
     /* Return result */
-    return this->projection_parameters.source_image;
+    return this->record.source_image;
 }
 
 /* Function to get projection azimuth */
 float ObjectRect::proj_azimuth()
 {
     /* Return result */
-    return this->projection_parameters.azimuth;
+    return this->record.azimuth;
 }
 
 /* Function to get projection elevation */
 float ObjectRect::proj_elevation()
 {
     /* Return result */
-    return this->projection_parameters.elevation;
+    return this->record.elevation;
 }
 
 /* Function to get projection aperture */
 float ObjectRect::proj_aperture()
 {
     /* Return result */
-    return this->projection_parameters.aperture;
+    return this->record.aperture;
 }
 
 /* Function to get projection projection point 1 */
 QPointF ObjectRect::proj_point_1()
 {
     /* Return result */
-    return this->projection_parameters.points[0];
+    return this->record.points[0];
 }
 
 /* Function to get projection projection point 2 */
 QPointF ObjectRect::proj_point_2()
 {
     /* Return result */
-    return this->projection_parameters.points[1];
+    return this->record.points[1];
 }
 
 /* Function to get projection projection point 3 */
 QPointF ObjectRect::proj_point_3()
 {
     /* Return result */
-    return this->projection_parameters.points[2];
+    return this->record.points[2];
 }
 
 /* Function to get projection projection point 4 */
 QPointF ObjectRect::proj_point_4()
 {
     /* Return result */
-    return this->projection_parameters.points[3];
+    return this->record.points[3];
 }
 
 /* Function to get projection width */
 float ObjectRect::proj_width()
 {
     /* Return result */
-    return this->projection_parameters.width;
+    return this->record.width;
 }
 
 /* Function to get projection height */
 float ObjectRect::proj_height()
 {
     /* Return result */
-    return this->projection_parameters.height;
+    return this->record.height;
 }
 
 /* Function to get object type (See ObjectType struct) */
 int ObjectRect::getObjectType()
 {
     /* Return result */
-    return this->info.type;
+    return this->record.type;
 }
 
 /* Function to set object type (See ObjectType struct) */
 void ObjectRect::setObjectType(int value)
 {
     /* Assign value */
-    this->info.type = value;
+    this->record.type = value;
 
     /* Apply special types colors */
     switch(value)
@@ -689,66 +699,66 @@ void ObjectRect::setObjectType(int value)
 int ObjectRect::getObjectSubType()
 {
     /* Return result */
-    return this->info.sub_type;
+    return this->record.sub_type;
 }
 
 /* Function to set object sub-type (See ObjectSubType) */
 void ObjectRect::setObjectSubType(int value)
 {
     /* Assign value */
-    this->info.sub_type = value;
+    this->record.sub_type = value;
 }
 
 /* Function to determine if object is marked for bluring */
 bool ObjectRect::isBlurred()
 {
     /* Return result */
-    return this->info.blurred;
+    return this->record.blurred;
 }
 
 /* Function to mark object for blurring or not */
 void ObjectRect::setBlurred(bool value)
 {
     /* Assign value */
-    this->info.blurred = value;
+    this->record.blurred = value;
 }
 
 /* Function to determine if object is validated */
 bool ObjectRect::isValidated()
 {
     /* Return result */
-    return (this->manual_state == ObjectManualState::Valid);
+    return (this->record.manual_state == ObjectManualState::Valid);
 }
 
 /* Function to get manual status */
-QString ObjectRect::getManualStatus()
+int ObjectRect::getManualStatus()
 {
     /* Return result */
-    return this->info.manual_status;
+    return this->record.manual_status;
 }
 
 /* Function to set manual status */
-void ObjectRect::setManualStatus(QString value)
+void ObjectRect::setManualStatus(int value)
 {
     /* Assign value */
-    this->info.manual_status = value;
+    this->record.manual_status = value;
 }
 
 /* Function to get automatic status */
-QString ObjectRect::getAutomaticStatus()
+int ObjectRect::getAutomaticStatus()
 {
     /* Return result */
-    return this->info.automatic_status;
+    return this->record.automatic_status;
 }
 
 /* Function to set automatic status */
-void ObjectRect::setAutomaticStatus(QString value)
+void ObjectRect::setAutomaticStatus(int value)
 {
     /* Assign value */
-    this->info.automatic_status = value;
+    this->record.automatic_status = value;
 
     /* If object is automatic disable resizing */
-    if(value != "None")
+    if(value != ObjectAutomaticStatus::None)
         this->setResizeEnabled( false );
 }
 
@@ -834,78 +844,105 @@ void ObjectRect::mergeWith(ObjectRect *rect)
 void ObjectRect::mapTo(float width, float height, float azimuth, float elevation, float aperture)
 {
     /* Destination points containers */
-    QPointF p1, p2, p3, p4;
-
-    /* Map point 1 */
-    g2g_point(this->proj_width(),
-              this->proj_height(),
-              this->proj_azimuth(),
-              this->proj_elevation(),
-              this->proj_aperture(),
-              this->proj_point_1().x(),
-              this->proj_point_1().y(),
-
-              width,
-              height,
-              azimuth,
-              elevation,
-              aperture,
-              &p1.rx(),
-              &p1.ry());
-
-    /* Map point 2 */
-    g2g_point(this->proj_width(),
-              this->proj_height(),
-              this->proj_azimuth(),
-              this->proj_elevation(),
-              this->proj_aperture(),
-              this->proj_point_2().x(),
-              this->proj_point_2().y(),
-
-              width,
-              height,
-              azimuth,
-              elevation,
-              aperture,
-              &p2.rx(),
-              &p2.ry());
-
-    /* Map point 3 */
-    g2g_point(this->proj_width(),
-              this->proj_height(),
-              this->proj_azimuth(),
-              this->proj_elevation(),
-              this->proj_aperture(),
-              this->proj_point_3().x(),
-              this->proj_point_3().y(),
-
-              width,
-              height,
-              azimuth,
-              elevation,
-              aperture,
-              &p3.rx(),
-              &p3.ry());
-
-    /* Map point 4 */
-    g2g_point(this->proj_width(),
-              this->proj_height(),
-              this->proj_azimuth(),
-              this->proj_elevation(),
-              this->proj_aperture(),
-              this->proj_point_4().x(),
-              this->proj_point_4().y(),
-
-              width,
-              height,
-              azimuth,
-              elevation,
-              aperture,
-              &p4.rx(),
-              &p4.ry());
+    QPointF p[4];
+
+    /* Map projection points */
+    this->record.mapTo( width, height, azimuth, elevation, aperture, p );
 
     /* Update current object points */
-    this->setPoints( p1, p2, p3, p4 );
+    this->setPoints( p[0], p[1], p[2], p[3] );
+}
+
+/* Function to project object points into a precomputed view frame, returns visibility */
+bool ObjectRect::project(const ProjectionContext &view, QPointF* mapped)
+{
+    /* Rebuild object projection context if projection parameters changed */
+    this->updateFrame();
+
+    /* Source / destination coordinates */
+    double r_x[4], r_y[4], c_x[4], c_y[4];
+    for( int i = 0; i < 4; i++ )
+    {
+        r_x[i] = this->record.points[i].x();
+        r_y[i] = this->record.points[i].y();
+    }
+
+    /* Map points */
+    int visible = this->frame.mapTo( view, 4, r_x, r_y, c_x, c_y );
+
+    /* Assign mapped points */
+    if( mapped != NULL )
+    {
+        for( int i = 0; i < 4; i++ )
+            mapped[i] = QPointF( c_x[i], c_y[i] );
+    }
+
+    /* Object is visible if all points are */
+    this->in_view = ( visible == 4 );
+    return this->in_view;
+}
+
+/* Function to map object to a precomputed view frame, returns visibility */
+bool ObjectRect::mapTo(const ProjectionContext &view)
+{
+    /* Destination points containers */
+    QPointF p[4];
+
+    /* Map projection points */
+    bool visible = this->project( view, p );
+
+    /* Update current object points */
+    this->setPoints( p[0], p[1], p[2], p[3] );
+
+    /* Return visibility */
+    return visible;
+}
+
+/* Function to update object visibility in a precomputed view frame */
+bool ObjectRect::updateInView(const ProjectionContext &view)
+{
+    /* Return visibility */
+    return this->project( view, NULL );
+}
+
+/* Function to get object visibility computed by last mapping */
+bool ObjectRect::isInView()
+{
+    /* Return value */
+    return this->in_view;
+}
+
+/* Function to get spherical cap enclosing object (spatial indexing) */
+sphere_cap_struct ObjectRect::getSphereCap()
+{
+    /* Rebuild object projection context if projection parameters changed */
+    this->updateFrame();
+
+    /* Projection points coordinates */
+    double r_x[4], r_y[4];
+    for( int i = 0; i < 4; i++ )
+    {
+        r_x[i] = this->record.points[i].x();
+        r_y[i] = this->record.points[i].y();
+    }
+
+    /* Return result */
+    return SphereIndex::cap( this->frame, 4, r_x, r_y );
+}
+
+/* Function to get objects geometry revision (changes with any projection parameters/points) */
+int ObjectRect::geometryRevision()
+{
+    /* Return value */
+    return ObjectRect::geometry_revision;
+}
+
+/* Function to rebuild object projection context if projection parameters changed */
+void ObjectRect::updateFrame()
+{
+    /* Compare with cached context parameters */
+    if( !this->frame.matches( this->record.width, this->record.height, this->record.azimuth, this->record.elevation, this->record.aperture ) )
+        this->frame = ProjectionContext( this->record.width, this->record.height, this->record.azimuth, this->record.elevation, this->record.aperture );
 }
 
 /* Function to convert spherical coordinates system to gnomonic */
@@ -919,77 +956,16 @@ void ObjectRect::mapFromSpherical(float source_width,
                                   float dest_zoom_min,
                                   float dest_zoom_max)
 {
-    /* Declare point containers */
-    QPointF p1, p3;
-
-    /* Denormalize point 1 */
-    double p1_d_x = ((this->getPoint1().x() / LG_PI2) * source_width);
-    double p1_d_y = (((this->getPoint1().y()) + ( LG_PI / 2.0 )) / LG_PI ) * source_height;
-
-    /* Denormalize point 2 */
-    double p3_d_x = ((this->getPoint3().x() / LG_PI2) * source_width);
-    double p3_d_y = (((this->getPoint3().y()) + ( LG_PI / 2.0 )) / LG_PI ) * source_height;
-
-    /* Determine width/height */
-    double width  = ( p3_d_x + p1_d_x );
-    double height = ( p3_d_y + p1_d_y );
-
-    /* Determine best aperture */
-    float aperture = ( ( ( p3_d_x - p1_d_x ) / source_width ) * 30.0 );
-
-    /* Clamp aperture */
-    aperture = aperture < dest_zoom_min ? dest_zoom_min : aperture;
-    aperture = aperture > dest_zoom_max ? dest_zoom_max : aperture;
-
-    /* Determine center */
-    double center_x = ( width / 2.0 );
-    double center_y = ( height / 2.0 );
-
-    /* Determine azimuth/elevation */
-    float azimuth = ( ( center_x / source_width ) * LG_PI2 );
-    float elevation = ( ( - ( center_y / source_height ) + 0.5 ) * LG_PI );
-
-    /* Convert point 1 */
-    etg_point(source_width,
-              source_height,
-              p1_d_x,
-              p1_d_y,
-              dest_width,
-              dest_height,
-              azimuth,
-              elevation,
-              aperture,
-              &p1.rx(),
-              &p1.ry());
-
-    /* Convert point 2 */
-    etg_point(source_width,
-              source_height,
-              p3_d_x,
-              p3_d_y,
-              dest_width,
-              dest_height,
-              azimuth,
-              elevation,
-              aperture,
-              &p3.rx(),
-              &p3.ry());
-
-    /* Update points */
-    this->setPoints(p1,
-                    QPointF(0.0, 0.0),
-                    p3,
-                    QPointF(0.0, 0.0));
-
-    /* Update projection points */
+    /* Use current points as spherical coordinates */
     this->setProjectionPoints();
 
-    /* Update projection parameters */
-    this->setProjectionParametters(azimuth,
-            elevation,
-            aperture,
-            dest_width,
-            dest_height);
+    /* Compute projection parameters / points */
+    this->record.mapFromSpherical(source_width,
+                                  source_height,
+                                  dest_width,
+                                  dest_height,
+                                  dest_zoom_min,
+                                  dest_zoom_max);
 
     /* Map points */
     this->mapTo(dest_width,
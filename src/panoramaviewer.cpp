@@ -40,6 +40,18 @@
 #include "panoramaviewer.h"
 #include "editview.h"
 
+/* Initial resolution factor of frames rendered while input is active (relative to scale factor) */
+#define PANORAMA_INTERACTIVE_SCALE 0.5
+
+/* Target render time (ms) of frames rendered while input is active */
+#define PANORAMA_TARGET_FRAME_TIME 16.0
+
+/* Minimal render scale of frames rendered while input is active */
+#define PANORAMA_MIN_SCALE 0.1
+
+/* Idle delay (ms) before full quality rendering */
+#define PANORAMA_IDLE_DELAY 150
+
 /* Constructor */
 PanoramaViewer::PanoramaViewer(QWidget *parent, bool connectSlots) :
     QGraphicsView(parent)
@@ -88,13 +100,40 @@ PanoramaViewer::PanoramaViewer(QWidget *parent, bool connectSlots) :
     this->createEnabled = true;
     this->editEnabled = true;
 
-    /* Initialize pixmap state container */
-    this->pixmap_initialized = false;
-
     /* Initialize in rect containers */
     this->increation_rect.rect = NULL;
     this->selected_rect = NULL;
 
+    /* Create image pyramid */
+    this->image_pyramid = new ImagePyramid();
+
+    /* Create frames renderer */
+    this->render_worker = new RenderWorker( this );
+    this->render_serial = 0;
+    this->frame_serial = 0;
+    this->frame_azimuth = this->position.azimuth;
+    this->frame_elevation = this->position.elevation;
+    this->frame_aperture = this->position.aperture;
+    this->frame_held = false;
+    this->held_render_time = 0.0;
+
+    /* Create full quality pass timer */
+    this->idle_timer = new QTimer( this );
+    this->idle_timer->setSingleShot( true );
+    this->idle_timer->setInterval( PANORAMA_IDLE_DELAY );
+    connect(this->idle_timer, SIGNAL(timeout()), this, SLOT(idleRender_slot()));
+
+    /* Connect signal for rendered frames (queued from worker thread) */
+    connect(this->render_worker, SIGNAL(frameReady(QImage,render_request_struct,float)), this, SLOT(frameReady_slot(QImage,render_request_struct,float)));
+
+    /* Initialize adaptive resolution of interactive frames */
+    this->interactive_scale = PANORAMA_INTERACTIVE_SCALE;
+
+    /* Initialize spatial index state (built on first use) */
+    this->indexed_count = -1;
+    this->indexed_revision = -1;
+    this->index_rebuilt = false;
+
     /* Initialize pressed keys container */
     this->pressed_keys.CTRL = false;
 
@@ -102,6 +141,11 @@ PanoramaViewer::PanoramaViewer(QWidget *parent, bool connectSlots) :
     this->scene = new QGraphicsScene();
     this->setScene(this->scene);
 
+    /* Add frame item to scene (under objects) */
+    this->frame_item = new FrameItem();
+    this->frame_item->setZValue(-1);
+    this->scene->addItem(this->frame_item);
+
     /* Create sight */
     QPen sight_pen;
 
@@ -115,8 +159,8 @@ PanoramaViewer::PanoramaViewer(QWidget *parent, bool connectSlots) :
     this->sight_width = 800;
 
     /* Add sight to scene */
-    this->sight = this->scene->addRect( this->dest_image_map.width() / 2,
-                                        this->dest_image_map.height() / 2,
+    this->sight = this->scene->addRect( this->dest_image.width() / 2,
+                                        this->dest_image.height() / 2,
                                         this->sight_width,
                                         this->sight_width,
                                         sight_pen);
@@ -126,9 +170,20 @@ PanoramaViewer::PanoramaViewer(QWidget *parent, bool connectSlots) :
     {
         connect(this, SIGNAL(refreshLabels()), parent, SLOT(refreshLabels()));
         connect(this, SIGNAL(updateScaleSlider(int)), parent, SLOT(updateScaleSlider(int)));
+        connect(this, SIGNAL(updateRenderTime(float,float)), parent, SLOT(updateRenderTime(float,float)));
     }
 }
 
+/* Destructor */
+PanoramaViewer::~PanoramaViewer()
+{
+    /* Stop frames renderer first (frame in progress may read pyramid levels) */
+    delete this->render_worker;
+
+    /* Release downsampled levels */
+    delete this->image_pyramid;
+}
+
 /* Main setup function */
 void PanoramaViewer::setup(int width,
                            int height,
@@ -156,22 +211,25 @@ void PanoramaViewer::loadImage(QString path)
     /* Save image path */
     this->image_path = path;
 
-    /* Create a temporary image */
-    IplImage * temp_image = NULL;
+    /* Wait for frame in progress and drop remap tables computed for previous image */
+    this->render_worker->clear();
 
-    /* Load image */
-    temp_image = cvLoadImage( path.toStdString().c_str(), CV_LOAD_IMAGE_UNCHANGED );
+    /* Release downsampled levels of previous image */
+    this->image_pyramid->clear();
 
-    /* Save image details */
-    this->image_info.channels = (temp_image->nChannels + 1);
-    this->image_info.width = temp_image->width;
-    this->image_info.height = temp_image->height;
+    /* Release previous image before decoding the new one */
+    if( this->image_info.image != NULL )
+    {
+        delete this->image_info.image;
+        this->image_info.image = NULL;
+    }
 
-    /* Convert it to QImage */
-    this->image_info.image = IplImage2QImage( temp_image );
+    /* Load image directly into its final buffer */
+    if( !loadPanorama( path, &this->image_info ) )
+        return;
 
-    /* Release temporary image */
-    cvReleaseImage( &temp_image );
+    /* Build downsampled levels once for wide aperture frames */
+    this->image_pyramid->build( this->image_info.image, this->threads_count );
 
     /* Render PanoramaViewer */
     this->render();
@@ -186,72 +244,104 @@ void PanoramaViewer::updateScene(float azimuth,
     if( this->image_info.image == NULL )
         return;
 
-    /* Compute destination image size */
-    int dest_width = this->width() * scale_factor;
-    int dest_height = this->height() * scale_factor;
+    /* Build frame request */
+    render_request_struct request = this->frameRequest( azimuth, elevation, zoom );
+
+    /* Render frame in this thread */
+    float render_time = 0.0;
+    QImage frame = this->render_worker->renderNow( request, &render_time );
+
+    /* Show frame */
+    this->showFrame( frame, request, render_time );
+}
+
+/* Function to build a frame request for given projection parameters */
+render_request_struct PanoramaViewer::frameRequest(float azimuth,
+                                                   float elevation,
+                                                   float zoom,
+                                                   bool interactive)
+{
+    /* Output variable */
+    render_request_struct request;
+
+    /* New frame serial */
+    request.serial = ++this->render_serial;
+
+    /* Compute destination image size (adaptive resolution while input is active, never above scale factor) */
+    float scale = interactive ? ( scale_factor * this->interactive_scale ) : scale_factor;
+    request.width = qMax( 1, (int) ( this->width() * scale ) );
+    request.height = qMax( 1, (int) ( this->height() * scale ) );
+
+    /* Source image (pyramid level matching destination texel density) */
+    request.source = this->image_pyramid->level( this->image_pyramid->select( request.width, zoom ) );
+
+    /* Interpolation (nearest neighbour while input is active) */
+    request.interpolation = interactive ? EtgInterpolation::Nearest : EtgInterpolation::Bilinear;
+
+    /* Remap table caching (interactive frames are never revisited, keep cache for full quality views) */
+    request.cache = !interactive;
 
     /* Clamp azimuth/elevation */
-    float clamped_azimuth = clampRad(azimuth, -360.0, 360.0);
-    float clamped_elevation = clamp(elevation, -90.0, 90.0);
+    request.azimuth = clampRad(azimuth, -360.0, 360.0);
+    request.elevation = clamp(elevation, -90.0, 90.0);
+    request.aperture = zoom;
+
+    /* Threads count */
+    request.threads = this->threads_count;
+
+    /* Return result */
+    return request;
+}
 
+/* Function to show a rendered frame in scene */
+void PanoramaViewer::showFrame(const QImage &frame,
+                               const render_request_struct &request,
+                               float render_time)
+{
     /* Save old size */
     this->position.old_width = this->dest_image.width();
     this->position.old_height = this->dest_image.height();
 
-    /* Allocate destination image */
-    this->dest_image = QImage (dest_width, dest_height, QImage::Format_RGB32);
-
-    /* Project gnomonic image */
-    lg_etg_apperturep(
-
-        ( inter_C8_t * ) this->image_info.image->bits(),
-        this->image_info.width,
-        this->image_info.height,
-        this->image_info.channels,
-        ( inter_C8_t * ) dest_image.bits(),
-        dest_width,
-        dest_height,
-        this->image_info.channels,
-        clamped_azimuth,
-        clamped_elevation,
-        0.0,
-        zoom,
-        li_bilinearf,
-        this->threads_count
-    );
-
-    /* Convert projected image to pixmap */
-    this->dest_image_map = QPixmap::fromImage(this->dest_image);
-
-    /* Check if pixmap has been already initialized */
-    if(this->pixmap_initialized)
-    {
-        /* Remove old pixmap */
-        this->scene->removeItem(this->last_pixmap);
-        delete this->last_pixmap;
-    } else {
-        /* Update value to true */
-        this->pixmap_initialized = true;
-    }
+    /* Assign frame and its projection parameters */
+    this->dest_image = frame;
+    this->frame_serial = request.serial;
+    this->frame_azimuth = request.azimuth;
+    this->frame_elevation = request.elevation;
+    this->frame_aperture = request.aperture;
 
-    /* Add pixmap to scene (panorama gnomonic */
-    this->last_pixmap = this->scene->addPixmap(this->dest_image_map);
-
-    /* Update z value (to see other objects */
-    this->last_pixmap->setZValue(-1);
+    /* Update frame item in place (painted straight from render target) */
+    this->frame_item->setFrame(this->dest_image);
 
     /* Set scene boundaries */
-    this->scene->setSceneRect(this->dest_image_map.rect());
+    this->scene->setSceneRect(this->dest_image.rect());
 
     /* Fit image in scene */
-    this->fitInView(this->dest_image_map.rect());
+    this->fitInView(this->dest_image.rect());
+
+    /* Frame scale factor (lower than scale factor for interactive frames) */
+    float frame_scale = (float) frame.width() / qMax( 1, this->width() );
 
     /* Update sight position */
-    this->sight->setPos( QPointF( (dest_width / 2) - ((this->sight_width / 2) * (this->scale_factor / this->position.aperture)),
-                                  (dest_height / 2) - ((this->sight_width / 2) * (this->scale_factor / this->position.aperture)) ) );
+    this->sight->setPos( QPointF( (frame.width() / 2) - ((this->sight_width / 2) * (frame_scale / request.aperture)),
+                                  (frame.height() / 2) - ((this->sight_width / 2) * (frame_scale / request.aperture)) ) );
 
     /* Update sight scale */
-    this->sight->setScale( this->scale_factor / this->position.aperture );
+    this->sight->setScale( frame_scale / request.aperture );
+
+    /* Adapt resolution of interactive frames to hold target render time */
+    if( request.interpolation == EtgInterpolation::Nearest && render_time > 0.0 )
+    {
+        /* Render time is proportional to pixels count, damp correction */
+        float correction = clamp( sqrt( PANORAMA_TARGET_FRAME_TIME / render_time ), 0.8, 1.25 );
+
+        /* Update resolution (relative to scale factor, never above it) */
+        this->interactive_scale = clamp( this->interactive_scale * correction,
+                                         PANORAMA_MIN_SCALE / this->scale_factor,
+                                         1.0 );
+    }
+
+    /* Show render time */
+    emit updateRenderTime( render_time, frame_scale );
 }
 
 /* Function to render panorama and all objects */
@@ -264,15 +354,87 @@ void PanoramaViewer::render()
         this->position.aperture
     );
 
-    /* Iterate over objects */
-    foreach(ObjectRect* rect, this->rect_list)
+    /* Map objects over new frame */
+    this->renderObjects();
+
+    /* Frame is full quality, cancel pending idle pass */
+    this->idle_timer->stop();
+}
+
+/* Function to request panorama rendering in worker thread (objects follow when frame lands) */
+void PanoramaViewer::requestRender(bool interactive)
+{
+    /* Exif if input image is not loaded */
+    if( this->image_info.image == NULL )
+        return;
+
+    /* Queue request (replaces any request not yet rendered) */
+    this->render_worker->request( this->frameRequest( this->position.azimuth,
+                                                      this->position.elevation,
+                                                      this->position.aperture,
+                                                      interactive ) );
+
+    /* Restart full quality pass delay after interactive frames */
+    if( interactive )
+        this->idle_timer->start();
+}
+
+/* Slot for full quality rendering once input is idle */
+void PanoramaViewer::idleRender_slot()
+{
+    /* Request full quality frame */
+    this->requestRender();
+}
+
+/* Slot for frames rendered by worker thread */
+void PanoramaViewer::frameReady_slot(QImage frame,
+                                     render_request_struct request,
+                                     float render_time)
+{
+    /* Drop frames older than shown one */
+    if( request.serial <= this->frame_serial )
+        return;
+
+    /* Hold frame while an object is edited (objects being edited are not mapped yet) */
+    if( this->mode == PanoramaViewerMode::ObjectCreate ||
+            this->mode == PanoramaViewerMode::ObjectMove ||
+            this->mode == PanoramaViewerMode::ObjectResize )
+    {
+        this->held_frame = frame;
+        this->held_request = request;
+        this->held_render_time = render_time;
+        this->frame_held = true;
+        return;
+    }
+
+    /* Show frame */
+    this->showFrame( frame, request, render_time );
+
+    /* Map objects over new frame */
+    this->renderObjects();
+}
+
+/* Function to map and show objects over shown frame */
+void PanoramaViewer::renderObjects()
+{
+    /* Compute view projection context once for all objects */
+    ProjectionContext view = this->viewFrame();
+
+    /* Query objects near view from spatial index */
+    this->updateIndex();
+    this->queryCandidates( view );
+
+    /* Iterate over objects near view */
+    foreach(ObjectRect* rect, this->candidates)
     {
         /* Object size filtering check */
         if( rect->getSize().width() < 1 ||
                rect->getSize().height() < 1 )
         {
-            /* Remove rect from list */
+            /* Remove rect from lists */
             this->rect_list.removeOne( rect );
+            this->candidates.removeOne( rect );
+            this->shown_objects.remove( rect );
             delete rect;
 
             /* Refresh main window labels */
@@ -280,12 +442,12 @@ void PanoramaViewer::render()
         } else {
 
             /* Check if object is manual */
-            if(rect->getAutomaticStatus() == "None")
+            if(rect->getAutomaticStatus() == ObjectAutomaticStatus::None)
             {
                 /* Check if current parameter are the same as object's projection parameters */
-                if( rect->proj_azimuth() != this->position.azimuth ||
-                        rect->proj_elevation() != this->position.elevation ||
-                        rect->proj_aperture() != this->position.aperture )
+                if( rect->proj_azimuth() != this->frame_azimuth ||
+                        rect->proj_elevation() != this->frame_elevation ||
+                        rect->proj_aperture() != this->frame_aperture )
                 {
                     /* Disable resizing */
                     rect->setResizeEnabled( false );
@@ -301,16 +463,87 @@ void PanoramaViewer::render()
             }
 
             /* Map object to current projection parameters */
-            rect->mapTo(this->dest_image_map.width(),
-                        this->dest_image_map.height(),
-                        this->position.azimuth,
-                        this->position.elevation,
-                        this->position.aperture);
+            rect->mapTo( view );
         }
     }
 
-    /* Apply visibility groups */
-    this->applyVisGroup();
+    /* Apply visibility groups (visibility computed by mapping) */
+    this->applyVisGroup( true );
+}
+
+/* Function to get size of full quality frames */
+QSize PanoramaViewer::fullFrameSize()
+{
+    /* Return value (scene size at scale factor) */
+    return QSize( qMax( 1, (int) ( this->width() * this->scale_factor ) ),
+                  qMax( 1, (int) ( this->height() * this->scale_factor ) ) );
+}
+
+/* Function to compute current view projection context (shared by all objects mappings) */
+ProjectionContext PanoramaViewer::viewFrame()
+{
+    /* Return value (parameters of shown frame) */
+    return ProjectionContext( this->dest_image.width(),
+                              this->dest_image.height(),
+                              this->frame_azimuth,
+                              this->frame_elevation,
+                              this->frame_aperture );
+}
+
+/* Function to rebuild spatial index if objects changed */
+void PanoramaViewer::updateIndex()
+{
+    /* Check if objects were added, removed or moved since last build */
+    if( this->indexed_count == this->rect_list.size() &&
+            this->indexed_revision == ObjectRect::geometryRevision() )
+        return;
+
+    /* Clear index */
+    this->object_index.clear();
+    this->indexed_objects.clear();
+
+    /* Insert objects caps */
+    foreach(ObjectRect* rect, this->rect_list)
+    {
+        this->object_index.insert( this->indexed_objects.size(), rect->getSphereCap() );
+        this->indexed_objects.append( rect );
+    }
+
+    /* Store index state */
+    this->indexed_count = this->rect_list.size();
+    this->indexed_revision = ObjectRect::geometryRevision();
+    this->index_rebuilt = true;
+
+    /* Previous candidates may reference removed objects */
+    this->candidates.clear();
+}
+
+/* Function to query objects near given view from spatial index */
+void PanoramaViewer::queryCandidates(const ProjectionContext &view)
+{
+    /* Query index with view cap */
+    QVector<int> items;
+    this->object_index.query( SphereIndex::cap( view ), &items );
+
+    /* Assign candidates */
+    this->candidates.clear();
+    for( int i = 0; i < items.size(); i++ )
+        this->candidates.append( this->indexed_objects[ items[i] ] );
+}
+
+/* Function to check if an object belongs to current visibility group */
+bool PanoramaViewer::isInVisGroup(ObjectRect* rect)
+{
+    /* Main visibility group switch */
+    switch (this->vis_group) {
+
+    case PanoramaViewerVisGroups::Automatic:
+        return rect->getAutomaticStatus() != ObjectAutomaticStatus::None;
+    case PanoramaViewerVisGroups::Manual:
+        return rect->getAutomaticStatus() == ObjectAutomaticStatus::None;
+    default:
+        return true;
+    }
 }
 
 /* Function to update zoom of current scene */
@@ -369,7 +602,16 @@ void PanoramaViewer::wheelEvent(QWheelEvent* event)
 
         /* Apply zoom level */
         if(this->position.aperture_delta != old_zoom)
-            this->setZoom(this->position.aperture_delta);
+        {
+            /* Backup current positions */
+            this->backupPosition();
+
+            /* Convert zoom value to radians */
+            this->position.aperture = ( this->position.aperture_delta * ( LG_PI / 180.0 ) );
+
+            /* Request low resolution scene rendering (GUI thread keeps handling input) */
+            this->requestRender( true );
+        }
 
     }
 }
@@ -393,9 +635,9 @@ void PanoramaViewer::mousePressEvent(QMouseEvent* event)
         /* Switch to mooving mode */
         this->mode = PanoramaViewerMode::Move;
 
-        /* Store base positions (Used to determine offset to move in panorama later) */
-        this->position.start_x = mouse_scene.x();
-        this->position.start_y = mouse_scene.y();
+        /* Store base positions in full scale frame coordinates (shown frame may be a low resolution one) */
+        this->position.start_x = event->pos().x() * this->scale_factor;
+        this->position.start_y = event->pos().y() * this->scale_factor;
 
         /* Store base directions (Used to determine offset to move in panorama later) */
         this->position.start_azimuth = this->position.azimuth / (LG_PI / 180.0);
@@ -406,6 +648,16 @@ void PanoramaViewer::mousePressEvent(QMouseEvent* event)
     /* Check presence of right click */
     else if (event->buttons() & Qt::RightButton)
     {
+        /* Objects are edited over full quality frames only (replace pending low resolution frame) */
+        if( this->dest_image.size() != this->fullFrameSize() || this->frame_serial != this->render_serial )
+        {
+            /* Render full quality frame in this thread */
+            this->render();
+
+            /* Update mouse coords to new frame */
+            mouse_scene = this->mapToScene(event->pos());
+        }
+
         /* Get item at mouse position */
         QGraphicsPolygonItem* clicked_poly = qgraphicsitem_cast<QGraphicsPolygonItem*>(this->itemAt(event->x(), event->y()));
 
@@ -557,6 +809,14 @@ void PanoramaViewer::mouseReleaseEvent(QMouseEvent *)
 
     // Disable mouse tracking
     this->setMouseTracking(false);
+
+    // Apply frame held back during object edition
+    if( this->frame_held )
+    {
+        this->frame_held = false;
+        this->frameReady_slot( this->held_frame, this->held_request, this->held_render_time );
+        this->held_frame = QImage();
+    }
 }
 
 /* Mouse move event */
@@ -565,17 +825,13 @@ void PanoramaViewer::mouseMoveEvent(QMouseEvent* event)
     /* Store normalized mouse coords */
     QPointF mouse_scene = this->mapToScene(event->pos());
 
-    /* Store mouse coords */
-    int MouseX = mouse_scene.x();
-    int MouseY = mouse_scene.y();
-
     /* Moving mouse section (move in panorama) */
     if(this->mode == PanoramaViewerMode::Move)
     {
 
-        /* Determine the displacement delta */
-        int delta_x = (MouseX - this->position.start_x);
-        int delta_y = (MouseY - this->position.start_y);
+        /* Determine the displacement delta (full scale frame coordinates) */
+        int delta_x = (event->pos().x() * this->scale_factor - this->position.start_x);
+        int delta_y = (event->pos().y() * this->scale_factor - this->position.start_y);
 
         /* Apply delta to azimuth and elevation */
         float azimuth   = (this->position.start_azimuth   - ( (delta_x * this->position.aperture) * 0.1 ) / (this->scale_factor * 2.0) );
@@ -588,8 +844,8 @@ void PanoramaViewer::mouseMoveEvent(QMouseEvent* event)
         this->position.azimuth   = clampRad(azimuth, -360.0, 360.0) * (LG_PI / 180.0);
         this->position.elevation = clamp(elevation, -90.0, 90.0) * (LG_PI / 180.0);
 
-        /* Render scene */
-        this->render();
+        /* Request low resolution scene rendering (GUI thread keeps handling input) */
+        this->requestRender( true );
 
     }
 
@@ -611,7 +867,7 @@ void PanoramaViewer::mouseMoveEvent(QMouseEvent* event)
             this->increation_rect.rect->setObjectAutomaticState( ObjectAutomaticState::Manual );
             this->increation_rect.rect->setObjectManualState( ObjectManualState::Valid );
             this->increation_rect.rect->setObjectType( ObjectType::None );
-            this->increation_rect.rect->setManualStatus( "Valid" );
+            this->increation_rect.rect->setManualStatus( ObjectManualStatus::Valid );
             this->increation_rect.rect->setBlurred( true );
 
             /* Assign id to object */
@@ -621,8 +877,8 @@ void PanoramaViewer::mouseMoveEvent(QMouseEvent* event)
             this->increation_rect.rect->setProjectionParametters(this->position.azimuth,
                     this->position.elevation,
                     this->position.aperture,
-                    this->dest_image.width(),
-                    this->dest_image.height());
+                    this->fullFrameSize().width(),
+                    this->fullFrameSize().height());
 
             /* Set object source image path */
             this->increation_rect.rect->setSourceImagePath( this->image_path );
@@ -704,8 +960,8 @@ void PanoramaViewer::mouseMoveEvent(QMouseEvent* event)
         this->selected_rect->setProjectionParametters(this->position.azimuth,
                 this->position.elevation,
                 this->position.aperture,
-                this->dest_image.width(),
-                this->dest_image.height());
+                this->fullFrameSize().width(),
+                this->fullFrameSize().height());
 
         /* Set projection points */
         this->selected_rect->setProjectionPoints();
@@ -749,8 +1005,8 @@ void PanoramaViewer::mouseMoveEvent(QMouseEvent* event)
         this->selected_rect->setProjectionParametters(this->position.azimuth,
                 this->position.elevation,
                 this->position.aperture,
-                this->dest_image.width(),
-                this->dest_image.height());
+                this->fullFrameSize().width(),
+                this->fullFrameSize().height());
 
         /* Set projection points */
         this->selected_rect->setProjectionPoints();
@@ -822,30 +1078,18 @@ QImage PanoramaViewer::cropObject(ObjectRect* rect)
     /* Delete temp rect */
     delete rect_mapped;
 
-    /* Create temporary destination image */
-    QImage temp_dest(this->width(), this->height(), QImage::Format_RGB32);
-
-    /* Project gnomonic image */
-    lg_etg_apperturep(
-
-        ( inter_C8_t * ) this->image_info.image->bits(),
-        this->image_info.width,
-        this->image_info.height,
-        this->image_info.channels,
-        ( inter_C8_t * ) temp_dest.bits(),
-        this->width(),
-        this->height(),
-        this->image_info.channels,
-        rect->proj_azimuth(),
-        rect->proj_elevation(),
-        0.0,
-        rect->proj_aperture(),
-        li_bilinearf,
-        this->threads_count
-    );
+    /* Check if selection is valid */
+    if( rect_sel.isEmpty() )
+        return QImage();
+
+    /* Create destination image (selection size only) */
+    QImage dest(rect_sel.size(), QImage::Format_RGB32);
 
-    /* Crop and return image */
-    return temp_dest.copy(rect_sel);
+    /* Project only selected region of gnomonic image */
+    etg_kernel_project_rect( this->image_info.image, &dest, this->width(), this->height(), rect_sel, rect->proj_azimuth(), rect->proj_elevation(), rect->proj_aperture(), this->threads_count );
+
+    /* Return image */
+    return dest;
 
 }
 
@@ -861,73 +1105,8 @@ void PanoramaViewer::backupPosition()
 /* Function to determine if an object is visible or not */
 bool PanoramaViewer::isObjectVisible(ObjectRect *rect)
 {
-
-    /* Check if point 1 is visible */
-    int state = g2g_point(rect->proj_width(),
-                          rect->proj_height(),
-                          rect->proj_azimuth(),
-                          rect->proj_elevation(),
-                          rect->proj_aperture(),
-                          rect->proj_point_1().x(),
-                          rect->proj_point_1().y(),
-
-                          this->dest_image_map.width(),
-                          this->dest_image_map.height(),
-                          this->position.azimuth,
-                          this->position.elevation,
-                          this->position.aperture);
-
-    /* Check if point 2 is visible */
-    int state2 = g2g_point(rect->proj_width(),
-                           rect->proj_height(),
-                           rect->proj_azimuth(),
-                           rect->proj_elevation(),
-                           rect->proj_aperture(),
-                           rect->proj_point_2().x(),
-                           rect->proj_point_2().y(),
-
-                           this->dest_image_map.width(),
-                           this->dest_image_map.height(),
-                           this->position.azimuth,
-                           this->position.elevation,
-                           this->position.aperture);
-
-    /* Check if point 3 is visible */
-    int state3 = g2g_point(rect->proj_width(),
-                           rect->proj_height(),
-                           rect->proj_azimuth(),
-                           rect->proj_elevation(),
-                           rect->proj_aperture(),
-                           rect->proj_point_3().x(),
-                           rect->proj_point_3().y(),
-
-                           this->dest_image_map.width(),
-                           this->dest_image_map.height(),
-                           this->position.azimuth,
-                           this->position.elevation,
-                           this->position.aperture);
-
-    /* Check if point 4 is visible */
-    int state4 = g2g_point(rect->proj_width(),
-                           rect->proj_height(),
-                           rect->proj_azimuth(),
-                           rect->proj_elevation(),
-                           rect->proj_aperture(),
-                           rect->proj_point_4().x(),
-                           rect->proj_point_4().y(),
-
-                           this->dest_image_map.width(),
-                           this->dest_image_map.height(),
-                           this->position.azimuth,
-                           this->position.elevation,
-                           this->position.aperture);
-
-    /* Return proper result */
-    if( state != 1 || state2 != 1 || state3 != 1 || state4 != 1) {
-        return false;
-    } else {
-        return true;
-    }
+    /* Return visibility in current view */
+    return rect->updateInView( this->viewFrame() );
 }
 
 /* Function to set the visibility group */
@@ -938,63 +1117,66 @@ void PanoramaViewer::setVisGroup(int visgroup)
 }
 
 /* Function to apply visibility groups */
-void PanoramaViewer::applyVisGroup()
+void PanoramaViewer::applyVisGroup(bool mapped)
 {
+    /* Compute objects visibility if not done by mapping */
+    if( !mapped && this->vis_group != PanoramaViewerVisGroups::InCreation )
+    {
+        /* Compute view projection context once for all objects */
+        ProjectionContext view = this->viewFrame();
+
+        /* Query objects near view from spatial index */
+        this->updateIndex();
+        this->queryCandidates( view );
+
+        /* Iterate over objects near view */
+        foreach(ObjectRect* obj, this->candidates)
+            obj->updateInView( view );
+    }
+
     /* Main visibility group switch */
     switch (this->vis_group) {
 
     case PanoramaViewerVisGroups::All:
+    case PanoramaViewerVisGroups::Automatic:
+    case PanoramaViewerVisGroups::Manual:
+    {
+        /* Objects shown by this pass */
+        QSet<ObjectRect*> shown;
 
-        /* Iterate over objects */
-        foreach(ObjectRect* obj, this->rect_list)
+        /* Iterate over objects near view */
+        foreach(ObjectRect* obj, this->candidates)
         {
-            /* Check if object is visible */
-            if( this->isObjectVisible( obj ) ){
+            /* Check if object is visible and belongs to visibility group */
+            if( obj->isInView() && this->isInVisGroup( obj ) )
+            {
                 obj->setVisible( true );
+                shown.insert( obj );
             } else {
                 obj->setVisible( false );
             }
         }
-        break;
-    case PanoramaViewerVisGroups::Automatic:
 
-        /* Iterate over objects */
-        foreach(ObjectRect* obj, this->rect_list)
+        /* Hide objects away from view (all objects if index was rebuilt) */
+        if( this->index_rebuilt )
         {
-            /* Check if object is visible */
-            if( this->isObjectVisible( obj ) )
+            foreach(ObjectRect* obj, this->rect_list)
             {
-                /* Check object is automatic */
-                if( obj->getAutomaticStatus().toLower() != "none" )
-                {
-                    obj->setVisible( true );
-                } else {
+                if( !shown.contains( obj ) )
                     obj->setVisible( false );
-                }
-            } else {
-                obj->setVisible( false );
             }
-        }
-        break;
-    case PanoramaViewerVisGroups::Manual:
-
-        /* Iterate over objects */
-            foreach(ObjectRect* obj, this->rect_list)
+        } else {
+            foreach(ObjectRect* obj, this->shown_objects)
             {
-                /* Check if object is visible */
-                if( this->isObjectVisible( obj ) )
-                {
-                    /* Check if object is manual */
-                    if( obj->getAutomaticStatus().toLower() == "none" )
-                    {
-                        obj->setVisible( true );
-                    } else {
-                        obj->setVisible( false );
-                    }
-                } else {
+                if( !shown.contains( obj ) )
                     obj->setVisible( false );
-                }
             }
+        }
+
+        /* Store shown objects */
+        this->shown_objects = shown;
+        this->index_rebuilt = false;
+    }
         break;
     case PanoramaViewerVisGroups::InCreation:
 
@@ -1004,6 +1186,9 @@ void PanoramaViewer::applyVisGroup()
              obj->setVisible( false );
         }
 
+        /* Clear shown objects */
+        this->shown_objects.clear();
+
         /* Check if in creation rect is valid */
         if( this->increation_rect.rect != NULL )
         {
@@ -1011,6 +1196,7 @@ void PanoramaViewer::applyVisGroup()
             if( this->isObjectVisible( this->increation_rect.rect ) )
             {
                 this->increation_rect.rect->setVisible( true );
+                this->shown_objects.insert( this->increation_rect.rect );
             } else {
                 this->increation_rect.rect->setVisible( false );
             }
@@ -1023,6 +1209,7 @@ void PanoramaViewer::applyVisGroup()
                 if( this->isObjectVisible( this->rect_list.last() ) )
                 {
                     this->rect_list.last()->setVisible( true );
+                    this->shown_objects.insert( this->rect_list.last() );
                 } else {
                     this->rect_list.last()->setVisible( false );
                 }
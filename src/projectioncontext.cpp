@@ -0,0 +1,255 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "projectioncontext.h"
+
+/* Constructor (invalid context, matches no parameters) */
+ProjectionContext::ProjectionContext()
+{
+    /* Identity rotations */
+    for( int i = 0; i < 3; i++ )
+    {
+        for( int j = 0; j < 3; j++ )
+            this->r2e[i][j] = this->e2r[i][j] = ( i == j ) ? 1.0 : 0.0;
+    }
+
+    /* Invalid parameters */
+    this->pixel_size = 0.0;
+    this->view_width = -1.0;
+    this->view_height = -1.0;
+    this->view_azimuth = 0.0;
+    this->view_elevation = 0.0;
+    this->view_aperture = 0.0;
+}
+
+/* Constructor (rectilinear view of given size and gnomonic projection parameters) */
+ProjectionContext::ProjectionContext(double width, double height, double azimuth, double elevation, double aperture)
+{
+    /* Create rotation matrices */
+    lg_algebra_r2erotation( this->r2e, azimuth, elevation, 0 );
+    lg_algebra_e2rrotation( this->e2r, azimuth, elevation, 0 );
+
+    /* Compute pixel size */
+    this->pixel_size = 2.0 * tan( aperture / 2.0 ) / width;
+
+    /* Assign projection parameters */
+    this->view_width = width;
+    this->view_height = height;
+    this->view_azimuth = azimuth;
+    this->view_elevation = elevation;
+    this->view_aperture = aperture;
+}
+
+/* Function to check if context was computed with given parameters */
+bool ProjectionContext::matches(double width, double height, double azimuth, double elevation, double aperture) const
+{
+    /* Compare projection parameters */
+    return this->view_width == width &&
+           this->view_height == height &&
+           this->view_azimuth == azimuth &&
+           this->view_elevation == elevation &&
+           this->view_aperture == aperture;
+}
+
+/* Function to map a point of this view into another view, returns first order visibility */
+bool ProjectionContext::mapTo(const ProjectionContext &dest, double x, double y, double* dest_x, double* dest_y) const
+{
+    /* Return value */
+    return this->mapTo( dest, 1, &x, &y, dest_x, dest_y ) == 1;
+}
+
+/* Function to map points of this view into another view, returns number of visible points */
+int ProjectionContext::mapTo(const ProjectionContext &dest, int count, const double* x, const double* y, double* dest_x, double* dest_y) const
+{
+    /* Composed rotation (this view to sphere to destination view) */
+    double m[3][3];
+    for( int i = 0; i < 3; i++ )
+    {
+        for( int j = 0; j < 3; j++ )
+        {
+            m[i][j] = dest.e2r[i][0] * this->r2e[0][j] +
+                      dest.e2r[i][1] * this->r2e[1][j] +
+                      dest.e2r[i][2] * this->r2e[2][j];
+        }
+    }
+
+    /* Views centers / destination scale */
+    double cx = this->view_width / 2.0;
+    double cy = this->view_height / 2.0;
+    double dest_cx = dest.view_width / 2.0;
+    double dest_cy = dest.view_height / 2.0;
+    double dest_scale = 1.0 / dest.pixel_size;
+
+    /* Visible points counter */
+    int visible = 0;
+
+    /* Convert points */
+    for( int i = 0; i < count; i++ )
+    {
+        /* Compute position in this view frame */
+        double p1 = ( x[i] - cx ) * this->pixel_size;
+        double p2 = ( y[i] - cy ) * this->pixel_size;
+
+        /* Apply composed rotation on position */
+        double q0 = m[0][0] + m[0][1] * p1 + m[0][2] * p2;
+        double q1 = m[1][0] + m[1][1] * p1 + m[1][2] * p2;
+        double q2 = m[2][0] + m[2][1] * p1 + m[2][2] * p2;
+
+        /* Compute coordinates in destination view (optional) */
+        if( dest_x != NULL && dest_y != NULL )
+        {
+            dest_x[i] = ( q1 / q0 ) * dest_scale + dest_cx;
+            dest_y[i] = ( q2 / q0 ) * dest_scale + dest_cy;
+        }
+
+        /* Compute first order visibility condition */
+        visible += ( q0 > 0 ) ? 1 : 0;
+    }
+
+    /* Return visible points count */
+    return visible;
+}
+
+/* Function to project an equirectangular point into this view, returns first order visibility */
+bool ProjectionContext::fromEquirectangular(double e_width, double e_height, double e_x, double e_y, double* x, double* y) const
+{
+    /* Return value */
+    return this->fromEquirectangular( e_width, e_height, 1, &e_x, &e_y, x, y ) == 1;
+}
+
+/* Function to project equirectangular points into this view, returns number of visible points */
+int ProjectionContext::fromEquirectangular(double e_width, double e_height, int count, const double* e_x, const double* e_y, double* x, double* y) const
+{
+    /* View center / scale */
+    double cx = this->view_width / 2.0;
+    double cy = this->view_height / 2.0;
+    double scale = 1.0 / this->pixel_size;
+
+    /* Visible points counter */
+    int visible = 0;
+
+    /* Convert points */
+    for( int i = 0; i < count; i++ )
+    {
+        /* Compute spherical angles */
+        double s_x = ( ( e_x[i] / e_width ) * LG_PI2 );
+        double s_y = ( ( e_y[i] / e_height ) - 0.5 ) * LG_PI;
+
+        /* Compute position on sphere */
+        double p0 = cos( s_x ) * cos( s_y );
+        double p1 = sin( s_x ) * cos( s_y );
+        double p2 = sin( s_y );
+
+        /* Apply rotation on position */
+        double q0 = this->e2r[0][0] * p0 + this->e2r[0][1] * p1 + this->e2r[0][2] * p2;
+        double q1 = this->e2r[1][0] * p0 + this->e2r[1][1] * p1 + this->e2r[1][2] * p2;
+        double q2 = this->e2r[2][0] * p0 + this->e2r[2][1] * p1 + this->e2r[2][2] * p2;
+
+        /* Compute coordinates in this view */
+        x[i] = ( q1 / q0 ) * scale + cx;
+        y[i] = ( q2 / q0 ) * scale + cy;
+
+        /* Compute first order visibility condition */
+        visible += ( q0 > 0 ) ? 1 : 0;
+    }
+
+    /* Return visible points count */
+    return visible;
+}
+
+/* Function to compute the unit direction on sphere of a point of this view */
+void ProjectionContext::toSphere(double x, double y, double* direction) const
+{
+    /* Compute position in this view frame */
+    double p1 = ( x - this->view_width / 2.0 ) * this->pixel_size;
+    double p2 = ( y - this->view_height / 2.0 ) * this->pixel_size;
+
+    /* Apply rotation on position */
+    double q0 = this->r2e[0][0] + this->r2e[0][1] * p1 + this->r2e[0][2] * p2;
+    double q1 = this->r2e[1][0] + this->r2e[1][1] * p1 + this->r2e[1][2] * p2;
+    double q2 = this->r2e[2][0] + this->r2e[2][1] * p1 + this->r2e[2][2] * p2;
+
+    /* Normalize direction */
+    double norm = sqrt( q0 * q0 + q1 * q1 + q2 * q2 );
+    direction[0] = q0 / norm;
+    direction[1] = q1 / norm;
+    direction[2] = q2 / norm;
+}
+
+/* Function to get view width */
+double ProjectionContext::width() const
+{
+    /* Return value */
+    return this->view_width;
+}
+
+/* Function to get view height */
+double ProjectionContext::height() const
+{
+    /* Return value */
+    return this->view_height;
+}
+
+/* Function to get view azimuth */
+double ProjectionContext::azimuth() const
+{
+    /* Return value */
+    return this->view_azimuth;
+}
+
+/* Function to get view elevation */
+double ProjectionContext::elevation() const
+{
+    /* Return value */
+    return this->view_elevation;
+}
+
+/* Function to get view aperture */
+double ProjectionContext::aperture() const
+{
+    /* Return value */
+    return this->view_aperture;
+}
+
+/* Function to get pixel size */
+double ProjectionContext::pixel() const
+{
+    /* Return value */
+    return this->pixel_size;
+}
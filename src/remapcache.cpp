@@ -0,0 +1,205 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "remapcache.h"
+
+/* Remap table key comparison operator */
+bool operator==(const remap_key_struct &a, const remap_key_struct &b)
+{
+    /* Return result */
+    return ( a.source_width == b.source_width &&
+             a.source_height == b.source_height &&
+             a.width == b.width &&
+             a.height == b.height &&
+             a.azimuth == b.azimuth &&
+             a.elevation == b.elevation &&
+             a.aperture == b.aperture );
+}
+
+/* Remap table key hash function */
+uint qHash(const remap_key_struct &key, uint seed)
+{
+    /* Combine key members */
+    uint hash = qHash( key.width, seed ) ^ ( qHash( key.height, seed ) << 1 );
+    hash ^= qHash( key.source_width, seed ) ^ ( qHash( key.source_height, seed ) << 3 );
+    hash ^= qHash( key.azimuth, seed ) ^ ( qHash( key.elevation, seed ) << 5 );
+    hash ^= qHash( key.aperture, seed ) << 7;
+
+    /* Return result */
+    return hash;
+}
+
+/* Constructor */
+RemapTable::RemapTable(int width, int height)
+{
+    /* Assign dimensions */
+    this->width = width;
+    this->height = height;
+
+    /* Allocate entries */
+    this->entries.resize( width * height );
+}
+
+/* Function to compute source coordinates and weights of every destination pixel */
+void RemapTable::build(const QImage* source,
+                       float azimuth,
+                       float elevation,
+                       float aperture,
+                       int threads)
+{
+    /* Compute projection frame */
+    etg_frame_struct frame;
+    etg_kernel_frame( &frame, source, this->width, this->height, azimuth, elevation, aperture );
+
+    /* Entries container */
+    remap_entry_struct* entries = this->entries.data();
+
+    /* Iterate over destination Y axis */
+    #pragma omp parallel for num_threads( threads ) schedule( static )
+    for( int y = 0; y < this->height; y++ )
+    {
+        /* Compute row entries */
+        etg_kernel_coords( &frame, y, 0, this->width, entries + ( y * this->width ) );
+    }
+}
+
+/* Function to render destination image using precomputed table */
+void RemapTable::gather(const QImage* source,
+                        QImage* dest,
+                        int threads,
+                        int interpolation) const
+{
+    /* Source image data */
+    const quint32* s_bits = (const quint32*) source->constBits();
+    int s_stride = source->bytesPerLine() / 4;
+
+    /* Destination image data */
+    uchar* d_bits = dest->bits();
+    int d_stride = dest->bytesPerLine();
+
+    /* Entries container */
+    const remap_entry_struct* entries = this->entries.constData();
+
+    /* Iterate over destination Y axis */
+    #pragma omp parallel for num_threads( threads ) schedule( static )
+    for( int y = 0; y < this->height; y++ )
+    {
+        /* Interpolate row pixels */
+        if( interpolation == EtgInterpolation::Nearest )
+            etg_kernel_gather_nearest( s_bits, s_stride, entries + ( y * this->width ), this->width, (quint32*) ( d_bits + y * d_stride ) );
+        else
+            etg_kernel_gather( s_bits, s_stride, entries + ( y * this->width ), this->width, (quint32*) ( d_bits + y * d_stride ) );
+    }
+}
+
+/* Function to get table memory cost in kilobytes */
+int RemapTable::cost() const
+{
+    /* Return result */
+    return qMax( 1, (int) ( ( this->entries.size() * sizeof( remap_entry_struct ) ) / 1024 ) );
+}
+
+/* Constructor */
+RemapCache::RemapCache(int max_size)
+{
+    /* Assign maximum cache size (in kilobytes) */
+    this->tables.setMaxCost( max_size * 1024 );
+}
+
+/* Function to drop all cached tables */
+void RemapCache::clear()
+{
+    /* Remove tables */
+    this->tables.clear();
+}
+
+/* Function to project gnomonic image using cached remap tables */
+void RemapCache::project(const QImage* source,
+                         QImage* dest,
+                         float azimuth,
+                         float elevation,
+                         float aperture,
+                         int threads,
+                         int interpolation,
+                         bool cache)
+{
+    /* Use libgnomonic generic kernel if CPU has no SIMD kernel (no tables, bilinear only) */
+    if( etg_kernel_type() == EtgKernel::Scalar )
+    {
+        etg_kernel_project( source, dest, azimuth, elevation, aperture, threads );
+        return;
+    }
+
+    /* Build table key */
+    remap_key_struct key;
+    key.source_width = source->width();
+    key.source_height = source->height();
+    key.width = dest->width();
+    key.height = dest->height();
+    key.azimuth = azimuth;
+    key.elevation = elevation;
+    key.aperture = aperture;
+
+    /* Look for an existing table */
+    RemapTable* table = this->tables.object( key );
+
+    /* Table found, only gather pixels */
+    if( table != NULL )
+    {
+        table->gather( source, dest, threads, interpolation );
+        return;
+    }
+
+    /* Uncached frame, project directly (avoids building a table that is never reused) */
+    if( !cache )
+    {
+        etg_kernel_project( source, dest, azimuth, elevation, aperture, threads, interpolation );
+        return;
+    }
+
+    /* Create and build a new table */
+    table = new RemapTable( dest->width(), dest->height() );
+    table->build( source, azimuth, elevation, aperture, threads );
+
+    /* Render destination image */
+    table->gather( source, dest, threads, interpolation );
+
+    /* Store table (cache takes ownership and may drop it immediately) */
+    this->tables.insert( key, table, table->cost() );
+}
@@ -0,0 +1,248 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "renderworker.h"
+
+/* Maximal number of reusable render targets (shown, queued and rendered frames) */
+#define RENDER_WORKER_TARGETS 3
+
+/* Function to release a render target user (target memory is freed with last user) */
+static void releaseTarget(void* info)
+{
+    /* Target container */
+    render_target_struct* target = (render_target_struct*) info;
+
+    /* Free target if no user left */
+    if( !target->users.deref() )
+    {
+        delete [] target->data;
+        delete target;
+    }
+}
+
+/* Constructor */
+RenderWorker::RenderWorker(QObject* parent) : QThread(parent)
+{
+    /* Register request type for queued signals */
+    qRegisterMetaType<render_request_struct>( "render_request_struct" );
+
+    /* Initialize state */
+    this->pending = false;
+    this->quit = false;
+
+    /* Start worker thread */
+    this->start();
+}
+
+/* Destructor */
+RenderWorker::~RenderWorker()
+{
+    /* Ask worker thread to stop */
+    {
+        QMutexLocker locker( &this->request_mutex );
+        this->quit = true;
+        this->request_wake.wakeOne();
+    }
+
+    /* Wait for worker thread */
+    this->wait();
+
+    /* Release render targets (shown frames keep theirs alive) */
+    foreach(render_target_struct* target, this->targets)
+        releaseTarget( target );
+}
+
+/* Function to request a frame in worker thread (replaces any pending request) */
+void RenderWorker::request(const render_request_struct &request)
+{
+    QMutexLocker locker( &this->request_mutex );
+
+    /* Replace pending request (stale requests are never rendered) */
+    this->next = request;
+    this->pending = true;
+
+    /* Wake worker thread */
+    this->request_wake.wakeOne();
+}
+
+/* Function to render a frame in calling thread (drops pending request), render time is in ms */
+QImage RenderWorker::renderNow(const render_request_struct &request,
+                               float* render_time)
+{
+    /* Drop pending request */
+    {
+        QMutexLocker locker( &this->request_mutex );
+        this->pending = false;
+    }
+
+    /* Wait for frame in progress and render */
+    QMutexLocker locker( &this->render_mutex );
+    return this->renderFrame( request, render_time );
+}
+
+/* Function to drop pending request and cached tables (waits for frame in progress) */
+void RenderWorker::clear()
+{
+    /* Drop pending request */
+    {
+        QMutexLocker locker( &this->request_mutex );
+        this->pending = false;
+    }
+
+    /* Wait for frame in progress and drop tables */
+    QMutexLocker locker( &this->render_mutex );
+    this->remap_cache.clear();
+}
+
+/* Function to render requested frames (runs in worker thread) */
+void RenderWorker::run()
+{
+    /* Iterate until stopped */
+    forever
+    {
+        /* Request to render */
+        render_request_struct request;
+
+        /* Take latest request */
+        {
+            QMutexLocker locker( &this->request_mutex );
+
+            /* Wait for a request */
+            while( !this->pending && !this->quit )
+                this->request_wake.wait( &this->request_mutex );
+
+            /* Check if worker is stopped */
+            if( this->quit )
+                return;
+
+            /* Take request */
+            request = this->next;
+            this->pending = false;
+        }
+
+        /* Rendered frame and its render time */
+        QImage frame;
+        float render_time = 0.0;
+
+        /* Render frame */
+        {
+            QMutexLocker locker( &this->render_mutex );
+            frame = this->renderFrame( request, &render_time );
+        }
+
+        /* Hand frame over (queued to receiver thread) */
+        emit frameReady( frame, request, render_time );
+    }
+}
+
+/* Function to get a frame image over an unused render target (render mutex must be held) */
+QImage RenderWorker::target(int width, int height)
+{
+    /* Frame memory size */
+    int size = width * height * 4;
+
+    /* Look for a target not used by any frame (pool is its only user) */
+    render_target_struct* target = NULL;
+    for( int i = 0; i < this->targets.size(); i++ )
+    {
+        if( this->targets[i]->users.load() == 1 )
+        {
+            target = this->targets[i];
+            break;
+        }
+    }
+
+    /* Create a target if all are in use (kept in pool while pool is not full) */
+    if( target == NULL )
+    {
+        target = new render_target_struct;
+        target->data = NULL;
+        target->capacity = 0;
+        target->users.store( 0 );
+
+        if( this->targets.size() < RENDER_WORKER_TARGETS )
+        {
+            target->users.ref();
+            this->targets.append( target );
+        }
+    }
+
+    /* Grow target memory (smaller frames reuse it as is) */
+    if( target->capacity < size )
+    {
+        delete [] target->data;
+        target->data = new uchar[size];
+        target->capacity = size;
+    }
+
+    /* Frame image becomes a target user */
+    target->users.ref();
+
+    /* Return result (frame image over target memory, released when last copy is destroyed) */
+    return QImage( target->data, width, height, width * 4, QImage::Format_RGB32, releaseTarget, target );
+}
+
+/* Function to render a frame and measure its render time (render mutex must be held) */
+QImage RenderWorker::renderFrame(const render_request_struct &request,
+                                 float* render_time)
+{
+    /* Start render timer */
+    QElapsedTimer timer;
+    timer.start();
+
+    /* Get destination image over a reusable render target */
+    QImage frame = this->target( request.width, request.height );
+
+    /* Project gnomonic image (remap table is reused if this view was already rendered) */
+    this->remap_cache.project( request.source,
+                               &frame,
+                               request.azimuth,
+                               request.elevation,
+                               request.aperture,
+                               request.threads,
+                               request.interpolation,
+                               request.cache );
+
+    /* Assign render time */
+    if( render_time != NULL )
+        *render_time = timer.nsecsElapsed() / 1000000.0;
+
+    /* Return result */
+    return frame;
+}
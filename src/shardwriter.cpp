@@ -0,0 +1,204 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "shardwriter.h"
+
+/* Tar block size */
+#define SHARD_BLOCK 512
+
+/* Constructor */
+ShardWriter::ShardWriter(QString exportPath, qint64 shard_size)
+{
+    /* Assign values */
+    this->path = exportPath;
+    this->shard_size = shard_size;
+    this->shard_index = 0;
+    this->tile_index = 0;
+
+    /* Create shards path if not exists */
+    if(!QDir( this->path ).exists())
+    {
+        QDir().mkpath( this->path );
+    }
+
+    /* Continue after existing shards (single directory scan) */
+    foreach(const QString &name, QDir( this->path ).entryList( QStringList() << "shard-*.tar", QDir::Files ))
+    {
+        /* Parse shard index */
+        bool ok = false;
+        int index = name.mid( 6, name.length() - 10 ).toInt( &ok );
+
+        /* Keep highest index */
+        if( ok && index >= this->shard_index )
+            this->shard_index = index + 1;
+    }
+}
+
+/* Destructor */
+ShardWriter::~ShardWriter()
+{
+    /* Terminate current shard */
+    this->close();
+}
+
+/* Function to open next shard */
+bool ShardWriter::openShard()
+{
+    /* Assign shard file name */
+    this->shard.setFileName( this->path + "/shard-" + QString( "%1" ).arg( this->shard_index, 6, 10, QChar( '0' ) ) + ".tar" );
+
+    /* Reset entries index */
+    this->tile_index = 0;
+
+    /* Open shard */
+    return this->shard.open( QIODevice::WriteOnly );
+}
+
+/* Function to terminate current shard, false if end of archive could not be written */
+bool ShardWriter::close()
+{
+    /* Lock writer */
+    QMutexLocker locker( &this->mutex );
+
+    /* Check if a shard is open */
+    if( this->shard.isOpen() )
+        return this->finishShard();
+
+    /* Return result */
+    return true;
+}
+
+/* Function to write end of archive marker and close current shard */
+bool ShardWriter::finishShard()
+{
+    /* Write end of archive marker (two zero blocks) */
+    bool result = this->shard.write( QByteArray( 2 * SHARD_BLOCK, '\0' ) ) == 2 * SHARD_BLOCK;
+
+    /* Close shard (flushes buffered entries) */
+    this->shard.close();
+    result = result && this->shard.error() == QFileDevice::NoError;
+
+    /* Next shard */
+    this->shard_index++;
+
+    /* Return result */
+    return result;
+}
+
+/* Function to append a file entry to current shard */
+bool ShardWriter::appendEntry(QString name, const QByteArray &data)
+{
+    /* Entry header (ustar) */
+    QByteArray header( SHARD_BLOCK, '\0' );
+    char* h = header.data();
+
+    /* Name, mode, owner */
+    qstrncpy( h, name.toLatin1().constData(), 100 );
+    qstrncpy( h + 100, "0000644", 8 );
+    qstrncpy( h + 108, "0000000", 8 );
+    qstrncpy( h + 116, "0000000", 8 );
+
+    /* Size and modification time (octal) */
+    qstrncpy( h + 124, QString( "%1" ).arg( data.size(), 11, 8, QChar( '0' ) ).toLatin1().constData(), 12 );
+    qstrncpy( h + 136, QString( "%1" ).arg( QDateTime::currentDateTime().toTime_t(), 11, 8, QChar( '0' ) ).toLatin1().constData(), 12 );
+
+    /* Regular file, ustar magic */
+    h[156] = '0';
+    memcpy( h + 257, "ustar\0" "00", 8 );
+
+    /* Compute checksum with checksum field set to spaces */
+    memset( h + 148, ' ', 8 );
+    unsigned int checksum = 0;
+    for( int i = 0; i < SHARD_BLOCK; i++ )
+        checksum += (unsigned char) h[i];
+    qstrncpy( h + 148, QString( "%1" ).arg( checksum, 6, 8, QChar( '0' ) ).toLatin1().constData(), 7 );
+
+    /* Write header and data */
+    if( this->shard.write( header ) != SHARD_BLOCK || this->shard.write( data ) != data.size() )
+        return false;
+
+    /* Pad data to block size */
+    int padding = ( SHARD_BLOCK - ( data.size() % SHARD_BLOCK ) ) % SHARD_BLOCK;
+    return this->shard.write( QByteArray( padding, '\0' ) ) == padding;
+}
+
+/* Function to append an encoded tile and its metadata to current shard (thread-safe) */
+bool ShardWriter::writeTile(const ObjectRecord &record, QRect selection, float zoom_level, const QByteArray &image, QString extension)
+{
+    /* Tile metadata */
+    QJsonObject metadata;
+    metadata["className"] = record.className();
+    metadata["subClassName"] = record.subClassName();
+    metadata["autoStatus"] = record.automaticStatusName();
+    metadata["manualStatus"] = record.manualStatusName();
+    metadata["azimuth"] = record.azimuth;
+    metadata["elevation"] = record.elevation;
+    metadata["aperture"] = record.aperture;
+    metadata["width"] = record.width;
+    metadata["height"] = record.height;
+    metadata["zoom"] = zoom_level;
+    metadata["selection"] = QJsonArray() << selection.x() << selection.y() << selection.width() << selection.height();
+    metadata["sourceImage"] = record.source_image;
+
+    /* Serialize metadata (outside of lock) */
+    QByteArray json = QJsonDocument( metadata ).toJson( QJsonDocument::Compact );
+
+    /* Lock writer */
+    QMutexLocker locker( &this->mutex );
+
+    /* Open a shard if needed */
+    if( !this->shard.isOpen() && !this->openShard() )
+        return false;
+
+    /* Entry key (shard / entry index, pairs image with metadata) */
+    QString key = QString( "%1_%2" ).arg( this->shard_index, 6, 10, QChar( '0' ) ).arg( this->tile_index, 6, 10, QChar( '0' ) );
+
+    /* Append image and metadata entries */
+    bool result = this->appendEntry( key + "." + extension, image ) && this->appendEntry( key + ".json", json );
+
+    /* Increment entries index */
+    this->tile_index++;
+
+    /* Start a new shard once size limit is reached */
+    if( this->shard.size() >= this->shard_size )
+        result = this->finishShard() && result;
+
+    /* Return result */
+    return result;
+}
@@ -0,0 +1,254 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "sphereindex.h"
+
+/* Constructor */
+SphereIndex::SphereIndex(int azimuth_cells, int elevation_cells)
+{
+    /* Assign grid dimensions */
+    this->azimuth_cells = azimuth_cells;
+    this->elevation_cells = elevation_cells;
+
+    /* Initialize query mark */
+    this->mark = 0;
+
+    /* Create grid cells */
+    this->cells.resize( this->azimuth_cells * this->elevation_cells );
+}
+
+/* Function to compute the cap enclosing points of a view */
+sphere_cap_struct SphereIndex::cap(const ProjectionContext &frame, int count, const double* x, const double* y)
+{
+    /* Output variable */
+    sphere_cap_struct result;
+
+    /* Points directions on sphere */
+    QVector<double> directions( count * 3 );
+
+    /* Sum of directions */
+    double sum[3] = { 0.0, 0.0, 0.0 };
+
+    /* Compute points directions */
+    for( int i = 0; i < count; i++ )
+    {
+        frame.toSphere( x[i], y[i], &directions[i * 3] );
+
+        for( int k = 0; k < 3; k++ )
+            sum[k] += directions[i * 3 + k];
+    }
+
+    /* Check if points have a mean direction */
+    double norm = sqrt( sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2] );
+    if( count == 0 || norm < 1e-12 )
+    {
+        /* Whole sphere cap */
+        result.direction[0] = 1.0;
+        result.direction[1] = 0.0;
+        result.direction[2] = 0.0;
+        result.radius = LG_PI;
+        return result;
+    }
+
+    /* Cap center is the mean direction */
+    for( int k = 0; k < 3; k++ )
+        result.direction[k] = sum[k] / norm;
+
+    /* Cap radius is the farthest point angle */
+    result.radius = 0.0;
+    for( int i = 0; i < count; i++ )
+    {
+        double dot = result.direction[0] * directions[i * 3] +
+                     result.direction[1] * directions[i * 3 + 1] +
+                     result.direction[2] * directions[i * 3 + 2];
+
+        result.radius = std::max( result.radius, acos( std::max( -1.0, std::min( 1.0, dot ) ) ) );
+    }
+
+    /* Caps wider than an hemisphere may not enclose the polygon edges, use whole sphere */
+    if( result.radius >= LG_PI / 2.0 )
+        result.radius = LG_PI;
+
+    /* Rounding margin */
+    result.radius += 1e-9;
+
+    /* Return result */
+    return result;
+}
+
+/* Function to compute the cap enclosing a whole view */
+sphere_cap_struct SphereIndex::cap(const ProjectionContext &frame)
+{
+    /* View corners */
+    double x[4] = { 0.0, 0.0, frame.width(), frame.width() };
+    double y[4] = { 0.0, frame.height(), frame.height(), 0.0 };
+
+    /* Return result */
+    return SphereIndex::cap( frame, 4, x, y );
+}
+
+/* Function to check if two caps intersect */
+bool SphereIndex::intersects(const sphere_cap_struct &a, const sphere_cap_struct &b)
+{
+    /* Caps centers angle */
+    double dot = a.direction[0] * b.direction[0] +
+                 a.direction[1] * b.direction[1] +
+                 a.direction[2] * b.direction[2];
+
+    /* Caps intersect if centers are closer than radii sum */
+    return acos( std::max( -1.0, std::min( 1.0, dot ) ) ) <= a.radius + b.radius;
+}
+
+/* Function to remove all items */
+void SphereIndex::clear()
+{
+    /* Clear grid cells */
+    for( int i = 0; i < this->cells.size(); i++ )
+        this->cells[i].clear();
+
+    /* Clear items */
+    this->caps.clear();
+    this->items.clear();
+    this->marks.clear();
+}
+
+/* Function to insert an item with its cap */
+void SphereIndex::insert(int item, const sphere_cap_struct &cap)
+{
+    /* Item index */
+    int index = this->caps.size();
+
+    /* Store item */
+    this->caps.append( cap );
+    this->items.append( item );
+    this->marks.append( this->mark );
+
+    /* Register item in covered cells */
+    QVector<int> covered;
+    this->cellsOf( cap, &covered );
+
+    for( int i = 0; i < covered.size(); i++ )
+        this->cells[ covered[i] ].append( index );
+}
+
+/* Function to query items whose caps intersect given cap (updates query marks, not reentrant) */
+void SphereIndex::query(const sphere_cap_struct &cap, QVector<int>* items) const
+{
+    /* Clear output */
+    items->clear();
+
+    /* New query mark */
+    this->mark++;
+
+    /* Cells covered by query cap */
+    QVector<int> covered;
+    this->cellsOf( cap, &covered );
+
+    /* Iterate over covered cells */
+    for( int i = 0; i < covered.size(); i++ )
+    {
+        const QVector<int> &cell = this->cells[ covered[i] ];
+
+        /* Iterate over cell items */
+        for( int j = 0; j < cell.size(); j++ )
+        {
+            int index = cell[j];
+
+            /* Skip items already tested */
+            if( this->marks[index] == this->mark )
+                continue;
+            this->marks[index] = this->mark;
+
+            /* Keep item if caps intersect */
+            if( SphereIndex::intersects( cap, this->caps[index] ) )
+                items->append( this->items[index] );
+        }
+    }
+}
+
+/* Function to get number of items */
+int SphereIndex::count() const
+{
+    /* Return value */
+    return this->items.size();
+}
+
+/* Function to compute cells covered by a cap */
+void SphereIndex::cellsOf(const sphere_cap_struct &cap, QVector<int>* covered) const
+{
+    /* Cap center angles */
+    double elevation = asin( std::max( -1.0, std::min( 1.0, cap.direction[2] ) ) );
+    double azimuth = atan2( cap.direction[1], cap.direction[0] );
+
+    /* Cap elevation bounds */
+    double elevation_min = elevation - cap.radius;
+    double elevation_max = elevation + cap.radius;
+
+    /* Covered rows */
+    int row_min = std::max( 0, (int) floor( ( elevation_min + LG_PI / 2.0 ) / LG_PI * this->elevation_cells ) );
+    int row_max = std::min( this->elevation_cells - 1, (int) floor( ( elevation_max + LG_PI / 2.0 ) / LG_PI * this->elevation_cells ) );
+
+    /* Covered columns (all if cap contains a pole) */
+    int col_min = 0;
+    int col_max = this->azimuth_cells - 1;
+    if( elevation_max < LG_PI / 2.0 && elevation_min > -LG_PI / 2.0 )
+    {
+        /* Cap azimuth half width */
+        double half = asin( std::min( 1.0, sin( cap.radius ) / cos( elevation ) ) );
+
+        /* Covered columns (may wrap around) */
+        int from = (int) floor( ( azimuth - half + LG_PI ) / LG_PI2 * this->azimuth_cells );
+        int to = (int) floor( ( azimuth + half + LG_PI ) / LG_PI2 * this->azimuth_cells );
+        if( to - from + 1 < this->azimuth_cells )
+        {
+            col_min = from;
+            col_max = to;
+        }
+    }
+
+    /* Collect covered cells */
+    for( int row = row_min; row <= row_max; row++ )
+    {
+        for( int col = col_min; col <= col_max; col++ )
+        {
+            int wrapped = ( ( col % this->azimuth_cells ) + this->azimuth_cells ) % this->azimuth_cells;
+            covered->append( row * this->azimuth_cells + wrapped );
+        }
+    }
+}
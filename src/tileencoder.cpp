@@ -0,0 +1,218 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "tileencoder.h"
+
+/* Function to get Qt image format name of an export format */
+static QString qtFormat(QString format)
+{
+    /* Raw tiles are stored as binary PPM (no compression) */
+    if( format == "raw" )
+        return "ppm";
+
+    /* Return result */
+    return format;
+}
+
+/* Constructor */
+EncoderThread::EncoderThread(BoundedQueue<encode_job_struct>* queue,
+                             QString format,
+                             int quality,
+                             ShardWriter* shards)
+{
+    /* Assign values */
+    this->queue = queue;
+    this->format = format;
+    this->quality = quality;
+    this->shards = shards;
+    this->failed = 0;
+}
+
+/* Function to get number of tiles that could not be encoded or written (valid once thread finished) */
+int EncoderThread::failures() const
+{
+    /* Return value */
+    return this->failed;
+}
+
+/* Function to encode and write queued tiles (runs in encoder thread) */
+void EncoderThread::run()
+{
+    /* Tile to encode */
+    encode_job_struct job;
+
+    /* Iterate until queue is closed and drained */
+    while( this->queue->pop( &job ) )
+    {
+        /* Encoded tile */
+        QByteArray data;
+        QBuffer buffer( &data );
+        buffer.open( QIODevice::WriteOnly );
+
+        /* Encode with selected codec / quality */
+        QImageWriter writer( &buffer, this->format.toLatin1() );
+        writer.setQuality( this->quality );
+
+        /* Check result */
+        if( !writer.write( job.tile ) )
+        {
+            /* Error output */
+            std::cerr << "Unable to encode tile: " << writer.errorString().toStdString() << std::endl;
+
+            /* Count failure */
+            this->failed++;
+            continue;
+        }
+
+        /* Append tile to shard */
+        if( this->shards )
+        {
+            /* Check result */
+            if( !this->shards->writeTile( job.record, job.selection, job.zoom_level, data, TileEncoder::extension( this->format ) ) )
+            {
+                /* Error output */
+                std::cerr << "Unable to write tile to shard." << std::endl;
+
+                /* Count failure */
+                this->failed++;
+            }
+
+        /* Write tile file */
+        } else {
+
+            /* Output file */
+            QFile file( job.destination );
+
+            /* Write encoded tile */
+            if( !file.open( QIODevice::WriteOnly ) || file.write( data ) != data.size() )
+            {
+                /* Error output */
+                std::cerr << "Unable to write tile: " << job.destination.toStdString() << std::endl;
+
+                /* Count failure */
+                this->failed++;
+            }
+        }
+    }
+}
+
+/* Constructor */
+TileEncoder::TileEncoder(QString format,
+                         int quality,
+                         int threads,
+                         ShardWriter* shards)
+{
+    /* Tiles queue (a few tiles per encoder bound memory use) */
+    this->queue = new BoundedQueue<encode_job_struct>( 4 * qMax( 1, threads ) );
+
+    /* Start encoder threads */
+    for( int i = 0; i < qMax( 1, threads ); i++ )
+    {
+        /* Create encoder */
+        EncoderThread* worker = new EncoderThread( this->queue, qtFormat( format ), quality, shards );
+
+        /* Start encoder */
+        worker->start();
+
+        /* Append to list */
+        this->workers.append( worker );
+    }
+}
+
+/* Destructor */
+TileEncoder::~TileEncoder()
+{
+    /* Wait for pending tiles */
+    this->finish();
+
+    /* Release encoders */
+    qDeleteAll( this->workers );
+
+    /* Release queue */
+    delete this->queue;
+}
+
+/* Function to queue a tile for encoding (blocks only while queue is full) */
+void TileEncoder::push(const encode_job_struct &job)
+{
+    /* Append to queue */
+    this->queue->push( job );
+}
+
+/* Function to wait until every queued tile is written, returns number of tiles that could not be encoded or written */
+int TileEncoder::finish()
+{
+    /* No more tiles */
+    this->queue->close();
+
+    /* Failed tiles counter */
+    int failed = 0;
+
+    /* Wait for encoders to drain the queue */
+    foreach(EncoderThread* worker, this->workers)
+    {
+        worker->wait();
+        failed += worker->failures();
+    }
+
+    /* Return result */
+    return failed;
+}
+
+/* Function to get tile file extension of an export format */
+QString TileEncoder::extension(QString format)
+{
+    /* JPEG */
+    if( format == "jpeg" )
+        return "jpg";
+
+    /* Return result */
+    return qtFormat( format );
+}
+
+/* Function to check if an export format is available */
+bool TileEncoder::isSupported(QString format)
+{
+    /* Check format name */
+    if( format != "png" && format != "jpeg" && format != "webp" && format != "raw" )
+        return false;
+
+    /* Check for image plugin (webp is optional in Qt) */
+    return QImageWriter::supportedImageFormats().contains( qtFormat( format ).toLatin1() );
+}
@@ -46,129 +46,169 @@ QImage* IplImage2QImage(IplImage *iplImg)
     int h = iplImg->height;
     int w = iplImg->width;
 
-    /* Get image channels */
-    int channels = iplImg->nChannels;
-
     /* Allocate destination image */
     QImage *qimg = new QImage(w, h, QImage::Format_ARGB32);
 
-    /* Get source image data */
-    char *data = iplImg->imageData;
+    /* Convert rows (BGR, BGRA or grayscale) into destination image */
+    bgr_swizzle_image( (const uchar*) iplImg->imageData,
+                       iplImg->widthStep,
+                       iplImg->nChannels,
+                       qimg,
+                       QThread::idealThreadCount() );
+
+    return qimg;
+}
+
+/* Function to load a panorama into an ARGB32 (or RGB32) image */
+bool loadPanorama(QString path, image_info_struct* image_info)
+{
+    /* Destination image */
+    QImage* image = NULL;
+
+    /* Open image with Qt to get its size and format without decoding it */
+    QImageReader reader( path );
+    QSize size = reader.size();
+    QImage::Format format = reader.imageFormat();
 
-    /* Iterate over image Y axis */
-    for (int y = 0; y < h; y++, data += iplImg->widthStep)
+    /* Check if Qt decodes this image straight into a 32 bits buffer */
+    if( size.isValid() && ( format == QImage::Format_RGB32 || format == QImage::Format_ARGB32 ) )
     {
-        /* Iterate over image X axis */
-        for (int x = 0; x < w; x++)
+        /* Allocate final image once, reader decodes into it when size and format match */
+        image = new QImage( size, format );
+
+        /* Decode image */
+        if( image->isNull() || !reader.read( image ) || image->size() != size )
         {
-            /* Initialize pixel color containers */
-            char r = 0;
-            char g = 0;
-            char b = 0;
-            char a = 0;
-
-            /* Channels check */
-            if (channels == 1)
-            {
-                /* Set red channel */
-                r = data[x * channels];
-
-                /* Set green channel */
-                g = data[x * channels];
-
-                /* Set blue channel */
-                b = data[x * channels];
-            }
-            else if (channels == 3 || channels == 4)
-            {
-                /* Set red channel */
-                r = data[x * channels + 2];
-
-                /* Set green channel */
-                g = data[x * channels + 1];
-
-                /* Set blue channel */
-                b = data[x * channels];
-            }
-
-            /* Channels check */
-            if (channels == 4)
-            {
-                /* Set alpha channel */
-                a = data[x * channels + 3];
-
-                /* Set pixel */
-                qimg->setPixel(x, y, qRgba(r, g, b, a));
-            }
-            else
-            {
-                /* Set pixel */
-                qimg->setPixel(x, y, qRgb(r, g, b));
-            }
+            /* Release image, fallback to OpenCV */
+            delete image;
+            image = NULL;
         }
     }
-    return qimg;
+
+    /* Fallback to OpenCV for other formats and layouts */
+    if( image == NULL )
+    {
+        /* Load image */
+        IplImage * temp_image = cvLoadImage( path.toStdString().c_str(), CV_LOAD_IMAGE_UNCHANGED );
+
+        /* Check if image was loaded */
+        if( temp_image == NULL )
+            return false;
+
+        /* Convert it to QImage */
+        image = IplImage2QImage( temp_image );
+
+        /* Release temporary image */
+        cvReleaseImage( &temp_image );
+    }
+
+    /* Save image details (source images are always 4 channels) */
+    image_info->image = image;
+    image_info->width = image->width();
+    image_info->height = image->height();
+    image_info->channels = 4;
+
+    return true;
 }
 
-/* Function to export an object to disk */
-void exportRect(ObjectRect *rect, image_info_struct image_info, QString destination, float zoom_level)
+/* Function to compute the tile selection of an object (thread-safe) */
+QRect exportSelection(const ObjectRecord &record, float zoom_level)
 {
-    /* Copy object */
-    ObjectRect* rect_mapped = rect->copy();
-
-    /* Map copied object to source object projection parameters */
-    rect_mapped->mapTo(rect->proj_width(),
-                       rect->proj_height(),
-                       rect->proj_azimuth(),
-                       rect->proj_elevation(),
-                       rect->proj_aperture() / zoom_level);
-
-    /* Update object projection points */
-    rect_mapped->setProjectionPoints();
-
-    /* Get selection from object's points */
-    QRect rect_sel(
-        QPoint(rect_mapped->proj_point_1().x() + rect_mapped->getBorderWidth(), rect_mapped->proj_point_1().y() + rect_mapped->getBorderWidth()),
-        QPoint(rect_mapped->proj_point_3().x() - rect_mapped->getBorderWidth(), rect_mapped->proj_point_3().y() - rect_mapped->getBorderWidth())
+    /* Check if rect sizes are correct */
+    if( record.getSize().width() < 1 || record.getSize().height() < 1 )
+        return QRect();
+
+    /* Map object points to zoomed projection parameters */
+    QPointF p[4];
+    record.mapTo(record.width,
+                 record.height,
+                 record.azimuth,
+                 record.elevation,
+                 record.aperture / zoom_level,
+                 p);
+
+    /* Mapped object */
+    ObjectRecord mapped = record;
+    mapped.setPoints( p[0], p[1], p[2], p[3] );
+
+    /* Border width drawn around object (thinner for small objects) */
+    QSizeF mapped_size = mapped.getSize();
+    float border_width = ( mapped_size.width() < 70 || mapped_size.height() < 70 ) ? 1 : 2;
+
+    /* Return selection from object's points */
+    return QRect(
+        QPoint(mapped.points[0].x() + border_width, mapped.points[0].y() + border_width),
+        QPoint(mapped.points[2].x() - border_width, mapped.points[2].y() - border_width)
     );
+}
 
-    /* Delete temp rect */
-    delete rect_mapped;
+/* Function to project and crop an object tile, resampled to size when valid (thread-safe) */
+QImage renderTile(const QImage* source, const ObjectRecord &record, QRect selection, float zoom_level, int threads, QSize size)
+{
+    /* Natural tile size (selection size) */
+    if( !size.isValid() )
+    {
+        /* Create destination image (selection size only) */
+        QImage element(selection.size(), QImage::Format_RGB32);
 
-    /* Create temporary destination image */
-    QImage temp_dest(rect->proj_width(), rect->proj_height(), QImage::Format_RGB32);
+        /* Project only selected region of gnomonic image */
+        etg_kernel_project_rect( source, &element, record.width, record.height, selection, record.azimuth, record.elevation, record.aperture / zoom_level, threads );
 
-    /* Determine best number of threads */
-    int threads_count = QThread::idealThreadCount();
+        /* Return result */
+        return element;
+    }
 
-    /* Check if rect sizes are correct */
-    if( rect->getSize().width() >= 1 &&
-           rect->getSize().height() >= 1 )
+    /* Grow selection around its center to requested aspect ratio (no distortion) */
+    double aspect = (double) size.width() / size.height();
+    double area_width = qMax( (double) selection.width(), selection.height() * aspect );
+    double area_height = area_width / aspect;
+    QRectF area( selection.x() + ( selection.width() - area_width ) / 2.0,
+                 selection.y() + ( selection.height() - area_height ) / 2.0,
+                 area_width,
+                 area_height );
+
+    /* Supersampling factor when tile is shrunk (avoids aliasing) */
+    int factor = qBound( 1, (int) floor( area_width / size.width() ), 4 );
+
+    /* Create destination image (requested size) */
+    QImage element(size, QImage::Format_RGB32);
+
+    /* Warp selection directly to requested size */
+    if( factor == 1 )
     {
+        etg_kernel_project_scaled( source, &element, record.width, record.height, area, record.azimuth, record.elevation, record.aperture / zoom_level, threads );
+
+    /* Warp at a multiple of requested size, then average pixel blocks */
+    } else {
+
+        /* Supersampled tile */
+        QImage supersampled(size.width() * factor, size.height() * factor, QImage::Format_RGB32);
 
-        /* Project gnomonic image */
-        lg_etg_apperturep(
-
-            ( inter_C8_t * ) image_info.image->bits(),
-            image_info.width,
-            image_info.height,
-            image_info.channels,
-            ( inter_C8_t * ) temp_dest.bits(),
-            rect->proj_width(),
-            rect->proj_height(),
-            image_info.channels,
-            rect->proj_azimuth(),
-            rect->proj_elevation(),
-            0.0,
-            rect->proj_aperture() / zoom_level,
-            li_bilinearf,
-            threads_count
-        );
-
-        /* Crop and save image */
-        QImage element = temp_dest.copy(rect_sel);
-        element.save( destination );
+        /* Warp and shrink */
+        etg_kernel_project_scaled( source, &supersampled, record.width, record.height, area, record.azimuth, record.elevation, record.aperture / zoom_level, threads );
+        etg_kernel_downsample( &supersampled, &element, factor, threads );
     }
+
+    /* Return result */
+    return element;
+}
+
+/* Function to project, crop and save an object tile (thread-safe) */
+void exportTile(const QImage* source, const ObjectRecord &record, QRect selection, float zoom_level, QString destination, int threads)
+{
+    /* Check if selection is valid */
+    if( selection.isEmpty() )
+        return;
+
+    /* Project, crop and save image */
+    renderTile( source, record, selection, zoom_level, threads ).save( destination );
+}
+
+/* Function to export an object to disk */
+void exportRect(const ObjectRecord &record, image_info_struct image_info, QString destination, float zoom_level)
+{
+    /* Project, crop and save object tile */
+    exportTile( image_info.image, record, exportSelection( record, zoom_level ), zoom_level, destination, QThread::idealThreadCount() );
 }
 
 /* Function to clamp a specified value */
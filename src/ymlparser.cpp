@@ -39,25 +39,32 @@
 /* Includes */
 #include "ymlparser.h"
 
+/* Function to compare a tag value with a lower case name (case insensitive, no copy) */
+static inline bool tagIs(const QString &tag, const char* name)
+{
+    /* Return result */
+    return tag.compare( QLatin1String( name ), Qt::CaseInsensitive ) == 0;
+}
+
 /* Constructor */
 YMLParser::YMLParser()
 {
 }
 
-/* Function to write ObjectRect list to YML file on disk */
-void YMLParser::writeYML(QList<ObjectRect*> objects, QString path)
+/* Function to write ObjectRecord list to YML file on disk, false if YML could not be written */
+bool YMLParser::writeYML(const QVector<ObjectRecord> &objects, QString path)
 {
-    /* Open storage for writing */
-    cv::FileStorage fs(path.toStdString(), cv::FileStorage::WRITE);
+    /* Open in memory storage for writing (format follows path extension) */
+    cv::FileStorage fs(path.toStdString(), cv::FileStorage::WRITE | cv::FileStorage::MEMORY);
 
     /* Write source file path */
-    fs << "source_image" << objects.first()->getSourceImagePath().toStdString();
+    fs << "source_image" << ( objects.isEmpty() ? std::string() : objects.first().source_image.toStdString() );
 
     /* Write objects */
     fs << "objects" << "[";
 
     /* Iterate over objects */
-    foreach (ObjectRect* obj, objects) {
+    foreach (const ObjectRecord &obj, objects) {
 
         /* Open array element */
         fs << "{";
@@ -66,10 +73,10 @@ void YMLParser::writeYML(QList<ObjectRect*> objects, QString path)
         this->writeItem(fs, obj);
 
         /* Write childrens if present */
-        if(obj->childrens.length() > 0)
+        if(obj.childrens.size() > 0)
         {
             fs << "childrens" << "[";
-            foreach (ObjectRect* child, obj->childrens) {
+            foreach (const ObjectRecord &child, obj.childrens) {
                 fs << "{";
                     this->writeItem(fs, child);
                 fs << "}";
@@ -83,52 +90,98 @@ void YMLParser::writeYML(QList<ObjectRect*> objects, QString path)
 
     /* Close array */
     fs << "]";
+
+    /* Get YML content */
+    std::string yml = fs.releaseAndGetString();
+    QByteArray content( yml.data(), (int) yml.size() );
+
+    /* Replace YML only once its whole content is on disk */
+    QSaveFile file( path );
+    if( !file.open( QIODevice::WriteOnly ) ||
+            file.write( content ) != content.size() ||
+            !file.commit() )
+    {
+        /* Info output */
+        std::cout << "Unable to write YML: " << path.toStdString() << std::endl;
+
+        /* Return result */
+        return false;
+    }
+
+    /* Write binary sidecar (a cache, the written YML stays authoritative if this fails) */
+    ObjectBinaryFile::write( objects, YMLParser::binaryPath( path ), path );
+
+    /* Return result */
+    return true;
 }
 
-/* Function load ObjectRect list from YML file on disk */
-QList<ObjectRect*> YMLParser::loadYML(QString path, int ymltype)
+/* Function to get binary sidecar path of a YML file */
+QString YMLParser::binaryPath(QString path)
+{
+    /* Return value */
+    return path.endsWith( ".bin" ) ? path : path + ".bin";
+}
+
+/* Function load ObjectRecord list from YML file on disk */
+QVector<ObjectRecord> YMLParser::loadYML(QString path, int ymltype)
 {
     /* Init output list */
-    QList<ObjectRect*> out_list;
+    QVector<ObjectRecord> out_list;
 
-    /* Read YML file */
-    cv::FileStorage fs(path.toStdString(), cv::FileStorage::READ);
+    /* Map binary file or up to date binary sidecar instead of parsing (validated objects only) */
+    if( ymltype == YMLType::Validator )
+    {
+        /* Binary file infos */
+        QFileInfo binary_info( YMLParser::binaryPath( path ) );
 
-    /* Retrieve objects node */
-    cv::FileNode objectsNode = fs["objects"];
+        /* Sidecar is outdated if YML changed since it was written (size or modification time differ) */
+        if( binary_info.exists() )
+        {
+            /* Convert mapped records */
+            ObjectBinaryFile binary;
+            if( binary.open( binary_info.filePath() ) && ( binary_info.filePath() == path || binary.matches( path ) ) )
+                return binary.objects();
+        }
+    }
 
-    /* Retrieve invalid objects node */
-    cv::FileNode invalidObjectsNode = fs["invalidObjects"];
+    /* Raw YML content */
+    yml_document_struct document;
+
+    /* Read YML file in one pass, use OpenCV storage for layouts the stream reader does not handle */
+    if( !this->stream_reader.read( path, &document ) )
+    {
+        document = yml_document_struct();
+        this->readDocument( path, &document );
+    }
+
+    /* Reserve output list */
+    out_list.reserve( document.objects.size() + document.invalid_objects.size() );
 
     /* Iterate over objects */
-    for (cv::FileNodeIterator it = objectsNode.begin(); it != objectsNode.end(); ++it) {
+    foreach (const yml_item_struct &item, document.objects) {
 
         /* Initialize detected object */
-        ObjectRect* object = this->readItem(it, ymltype);
+        ObjectRecord object = this->buildItem(item, ymltype);
 
         /* Assign source image path */
-        std::string source_image;
-        fs["source_image"] >> source_image;
-        object->setSourceImagePath( QString(source_image.c_str()) );
+        object.source_image = document.source_image;
 
         /* Append to list */
         out_list.append(object);
     }
 
     /* Iterate over objects */
-    for (cv::FileNodeIterator it = invalidObjectsNode.begin(); it != invalidObjectsNode.end(); ++it) {
+    foreach (const yml_item_struct &item, document.invalid_objects) {
 
         /* Initialize detected object */
-        ObjectRect* object = this->readItem(it, ymltype);
+        ObjectRecord object = this->buildItem(item, ymltype);
 
         /* Assign object automatic state / status */
-        object->setObjectAutomaticState( ObjectAutomaticState::Invalid );
-        object->setAutomaticStatus( (object->getAutomaticStatus().length() <= 0 || object->getAutomaticStatus() == "None") ? "MissingOption" : object->getAutomaticStatus() );
+        object.automatic_state = ObjectAutomaticState::Invalid;
+        object.automatic_status = object.automatic_status == ObjectAutomaticStatus::None ? ObjectAutomaticStatus::MissingOption : object.automatic_status;
 
         /* Assign source image path */
-        std::string source_image;
-        fs["source_image"] >> source_image;
-        object->setSourceImagePath( QString(source_image.c_str()) );
+        object.source_image = document.source_image;
 
         /* Append to list */
         out_list.append(object);
@@ -138,211 +191,222 @@ QList<ObjectRect*> YMLParser::loadYML(QString path, int ymltype)
     return out_list;
 }
 
-/* Function to write specific ObjectRect into YML file */
-void YMLParser::writeItem(cv::FileStorage &fs, ObjectRect* obj)
+/* Function to read raw YML content with OpenCV storage */
+void YMLParser::readDocument(QString path, yml_document_struct* document)
 {
-    /* Write type */
-    switch(obj->getObjectType())
-    {
-    case ObjectType::Face:
-        fs << "className" << "Face";
-        break;
-    case ObjectType::NumberPlate:
-        fs << "className" << "NumberPlate";
-        break;
-    case ObjectType::ToBlur:
-        fs << "className" << "ToBlur";
-        break;
-    case ObjectType::None:
-        fs << "className" << "None";
-        break;
+    /* Read YML file */
+    cv::FileStorage fs(path.toStdString(), cv::FileStorage::READ);
+
+    /* Retrieve objects node */
+    cv::FileNode objectsNode = fs["objects"];
+
+    /* Retrieve invalid objects node */
+    cv::FileNode invalidObjectsNode = fs["invalidObjects"];
+
+    /* Read source image path (shared by all objects) */
+    std::string source_image;
+    fs["source_image"] >> source_image;
+    document->source_image = QString( source_image.c_str() );
+
+    /* Iterate over objects */
+    for (cv::FileNodeIterator it = objectsNode.begin(); it != objectsNode.end(); ++it) {
+        document->objects.append( this->readItem(it) );
     }
 
-    /* Write sub-type */
-    switch(obj->getObjectSubType())
-    {
-    case ObjectSubType::None:
-        fs << "subClassName" << "None";
-        break;
-    case ObjectSubType::Front:
-        fs << "subClassName" << "Front";
-        break;
-    case ObjectSubType::Profile:
-        fs << "subClassName" << "Profile";
-        break;
-    case ObjectSubType::Back:
-        fs << "subClassName" << "Back";
-        break;
-    case ObjectSubType::Top:
-        fs << "subClassName" << "Top";
-        break;
-    case ObjectSubType::Eyes:
-        fs << "subClassName" << "Eyes";
-        break;
+    /* Iterate over invalid objects */
+    for (cv::FileNodeIterator it = invalidObjectsNode.begin(); it != invalidObjectsNode.end(); ++it) {
+        document->invalid_objects.append( this->readItem(it) );
     }
+}
+
+/* Function to write specific ObjectRecord into YML file */
+void YMLParser::writeItem(cv::FileStorage &fs, const ObjectRecord &obj)
+{
+    /* Write type */
+    fs << "className" << obj.className().toStdString();
+
+    /* Write sub-type */
+    fs << "subClassName" << obj.subClassName().toStdString();
 
     /* Write square area coodinates */
     fs << "area" << "{";
-        fs << "p1" << cv::Point2d(obj->proj_point_1().x(), obj->proj_point_1().y());
-        fs << "p2" << cv::Point2d(obj->proj_point_2().x(), obj->proj_point_2().y());
-        fs << "p3" << cv::Point2d(obj->proj_point_3().x(), obj->proj_point_3().y());
-        fs << "p4" << cv::Point2d(obj->proj_point_4().x(), obj->proj_point_4().y());
+        fs << "p1" << cv::Point2d(obj.points[0].x(), obj.points[0].y());
+        fs << "p2" << cv::Point2d(obj.points[1].x(), obj.points[1].y());
+        fs << "p3" << cv::Point2d(obj.points[2].x(), obj.points[2].y());
+        fs << "p4" << cv::Point2d(obj.points[3].x(), obj.points[3].y());
     fs << "}";
 
     /* Write projection parameters */
     fs << "params" << "{";
-        fs << "azimuth" << obj->proj_azimuth();
-        fs << "elevation" << obj->proj_elevation();
-        fs << "aperture" << obj->proj_aperture();
-        fs << "width" << obj->proj_width();
-        fs << "height" << obj->proj_height();
+        fs << "azimuth" << obj.azimuth;
+        fs << "elevation" << obj.elevation;
+        fs << "aperture" << obj.aperture;
+        fs << "width" << obj.width;
+        fs << "height" << obj.height;
     fs << "}";
 
     /* Write status tags */
-    fs << "autoStatus" << obj->getAutomaticStatus().toStdString();
-    fs << "manualStatus" << obj->getManualStatus().toStdString();
-    fs << "blurObject" << (obj->isBlurred() ? "Yes" : "No");
+    fs << "autoStatus" << obj.automaticStatusName().toStdString();
+    fs << "manualStatus" << obj.manualStatusName().toStdString();
+    fs << "blurObject" << (obj.blurred ? "Yes" : "No");
 }
 
-/* Function to read specific ObjectRect from YML file */
-ObjectRect* YMLParser::readItem(cv::FileNodeIterator iterator, int ymltype)
+/* Function to read a string node from OpenCV storage */
+static QString readString(const cv::FileNode &node)
 {
-    /* Initialize detected object */
-    ObjectRect* object = new ObjectRect;
+    /* Read value */
+    std::string value;
+    node >> value;
 
-    /* Parse falsePositive tag */
-    std::string falsePositive;
-    (*iterator)["falsePositive"] >> falsePositive;
-    QString lowerFalsePositive = QString( falsePositive.c_str() ).toLower();
+    /* Return result */
+    return QString( value.c_str() );
+}
 
-    /* Parse class name */
-    std::string className;
-    (*iterator)["className"] >> className;
+/* Function to read raw fields of an object from OpenCV storage */
+yml_item_struct YMLParser::readItem(cv::FileNodeIterator iterator)
+{
+    /* Raw object */
+    yml_item_struct item;
 
-    /* Parse sub class name */
-    std::string subClassName;
-    (*iterator)["subClassName"] >> subClassName;
+    /* Parse tags */
+    item.false_positive = readString( (*iterator)["falsePositive"] );
+    item.class_name = readString( (*iterator)["className"] );
+    item.sub_class_name = readString( (*iterator)["subClassName"] );
+    item.auto_status = readString( (*iterator)["autoStatus"] );
+    item.manual_status = readString( (*iterator)["manualStatus"] );
+    item.blur_object = readString( (*iterator)["blurObject"] );
 
-    /* Convert values to lower case */
-    QString lowerClassName = QString( className.c_str() ).toLower();
-    QString lowerSubClassName = QString( subClassName.c_str() ).toLower();
+    /* Parse area points */
+    cv::FileNode areaNode = (*iterator)["area"];
+    cv::Point2d pt_1;
+    cv::Point2d pt_2;
+    cv::Point2d pt_3;
+    cv::Point2d pt_4;
+
+    /* Read coordinates */
+    areaNode["p1"] >> pt_1;
+    areaNode["p2"] >> pt_2;
+    areaNode["p3"] >> pt_3;
+    areaNode["p4"] >> pt_4;
+
+    /* Assign points */
+    item.points[0] = QPointF( pt_1.x, pt_1.y );
+    item.points[1] = QPointF( pt_2.x, pt_2.y );
+    item.points[2] = QPointF( pt_3.x, pt_3.y );
+    item.points[3] = QPointF( pt_4.x, pt_4.y );
+
+    /* Parse gnomonic parameters */
+    cv::FileNode paramsNode = (*iterator)["params"];
+    paramsNode["azimuth"] >> item.azimuth;
+    paramsNode["elevation"] >> item.elevation;
+    paramsNode["aperture"] >> item.aperture;
+    paramsNode["width"] >> item.width;
+    paramsNode["height"] >> item.height;
+
+    /* Parse childrens */
+    cv::FileNode childNode = (*iterator)["childrens"];
+    for (cv::FileNodeIterator child = childNode.begin(); child != childNode.end(); ++child) {
+        item.childrens.append( this->readItem( child ) );
+    }
+
+    /* Return result */
+    return item;
+}
+
+/* Function to build an ObjectRecord from raw YML fields */
+ObjectRecord YMLParser::buildItem(const yml_item_struct &item, int ymltype)
+{
+    /* Initialize detected object */
+    ObjectRecord object;
 
     /* Assign object type */
-    if(lowerClassName == "face")
+    if(tagIs( item.class_name, "face" ))
     {
-        object->setObjectType( ObjectType::Face );
-    } else if (lowerClassName == "front" || lowerClassName == "front:profile"){
-        object->setObjectType( ObjectType::Face );
-        object->setObjectSubType( ObjectSubType::Front );
-    } else if (lowerClassName == "profile"){
-        object->setObjectType( ObjectType::Face );
-        object->setObjectSubType( ObjectSubType::Profile );
-    } else if(lowerClassName == "numberplate") {
-        object->setObjectType( ObjectType::NumberPlate );
-    } else if(lowerClassName == "toblur") {
-        object->setObjectType( ObjectType::ToBlur );
-    } else if(lowerClassName == "none") {
-        object->setObjectType( ObjectType::None );
+        object.type = ObjectType::Face;
+    } else if (tagIs( item.class_name, "front" ) || tagIs( item.class_name, "front:profile" )){
+        object.type = ObjectType::Face;
+        object.sub_type = ObjectSubType::Front;
+    } else if (tagIs( item.class_name, "profile" )){
+        object.type = ObjectType::Face;
+        object.sub_type = ObjectSubType::Profile;
+    } else if(tagIs( item.class_name, "numberplate" )) {
+        object.type = ObjectType::NumberPlate;
+    } else if(tagIs( item.class_name, "toblur" )) {
+        object.type = ObjectType::ToBlur;
+    } else if(tagIs( item.class_name, "none" )) {
+        object.type = ObjectType::None;
     }
 
     /* Assign object sub-type */
-    if(lowerSubClassName == "none")
+    if(tagIs( item.sub_class_name, "none" ))
     {
-        object->setObjectSubType( ObjectSubType::None );
-    } else if(lowerSubClassName == "front") {
-        object->setObjectSubType( ObjectSubType::Front );
-    } else if(lowerSubClassName == "profile") {
-        object->setObjectSubType( ObjectSubType::Profile );
-    } else if(lowerSubClassName == "back") {
-        object->setObjectSubType( ObjectSubType::Back );
-    } else if(lowerSubClassName == "top") {
-        object->setObjectSubType( ObjectSubType::Top );
-    } else if(lowerSubClassName == "eyes") {
-        object->setObjectSubType( ObjectSubType::Eyes );
+        object.sub_type = ObjectSubType::None;
+    } else if(tagIs( item.sub_class_name, "front" )) {
+        object.sub_type = ObjectSubType::Front;
+    } else if(tagIs( item.sub_class_name, "profile" )) {
+        object.sub_type = ObjectSubType::Profile;
+    } else if(tagIs( item.sub_class_name, "back" )) {
+        object.sub_type = ObjectSubType::Back;
+    } else if(tagIs( item.sub_class_name, "top" )) {
+        object.sub_type = ObjectSubType::Top;
+    } else if(tagIs( item.sub_class_name, "eyes" )) {
+        object.sub_type = ObjectSubType::Eyes;
     }
 
-    /* Parse area points */
-    cv::FileNode areaNode = (*iterator)["area"];
-    cv::Point2d pt_1;
-    cv::Point2d pt_2;
-    cv::Point2d pt_3;
-    cv::Point2d pt_4;
-
     /* Read coordinates */
+    QPointF pt_1 = item.points[0];
+    QPointF pt_2;
+    QPointF pt_3;
+    QPointF pt_4;
+
+    /* Points layout switch */
     switch(ymltype)
     {
     case YMLType::Detector:
 
-        /* Parse square edges points */
-        areaNode["p1"] >> pt_1;
-        areaNode["p2"] >> pt_3;
+        /* Square edges points */
+        pt_3 = item.points[1];
         break;
     case YMLType::Validator:
 
-        /* Parse polygon points */
-        areaNode["p1"] >> pt_1;
-        areaNode["p2"] >> pt_2;
-        areaNode["p3"] >> pt_3;
-        areaNode["p4"] >> pt_4;
+        /* Polygon points */
+        pt_2 = item.points[1];
+        pt_3 = item.points[2];
+        pt_4 = item.points[3];
         break;
     }
 
     /* Set object coordinates */
-    object->setPoints(QPointF(pt_1.x, pt_1.y),
-                      QPointF(pt_2.x, pt_2.y),
-                      QPointF(pt_3.x, pt_3.y),
-                      QPointF(pt_4.x, pt_4.y));
-
-    /* Parse gnomonic parameters */
-    cv::FileNode paramsNode = (*iterator)["params"];
-    float azimuth = 0.0;
-    float elevation = 0.0;
-    float aperture = 0.0;
-    float width = 0.0;
-    float height = 0.0;
-
-    paramsNode["azimuth"] >> azimuth;
-    paramsNode["elevation"] >> elevation;
-    paramsNode["aperture"] >> aperture;
-    paramsNode["width"] >> width;
-    paramsNode["height"] >> height;
+    object.setPoints(pt_1, pt_2, pt_3, pt_4);
 
     /* Set object projection parameters */
-    object->setProjectionParametters(azimuth,
-                                    elevation,
-                                    aperture,
-                                    width,
-                                    height);
+    object.azimuth = item.azimuth;
+    object.elevation = item.elevation;
+    object.aperture = item.aperture;
+    object.width = item.width;
+    object.height = item.height;
 
-    /* Set object projection points */
-    object->setProjectionPoints();
-
-    /* Parse auto status */
-    std::string autoStatus;
-    (*iterator)["autoStatus"] >> autoStatus;
-
-    /* Convert values to lower case */
-    QString lowerAutoStatus = QString( autoStatus.c_str() ).toLower();
-    lowerAutoStatus = lowerAutoStatus.length() > 0 ? lowerAutoStatus : "none";
+    /* Missing auto status means manual object */
+    bool manual = item.auto_status.length() <= 0 || tagIs( item.auto_status, "none" );
 
     /* Check presence of auto status */
-    if(lowerAutoStatus != "none")
+    if(!manual)
     {
         /* Check if auto status is valid */
-        if(lowerAutoStatus == "valid")
+        if(tagIs( item.auto_status, "valid" ))
         {
             /* Set values */
-            object->setObjectAutomaticState( ObjectAutomaticState::Valid );
-            object->setAutomaticStatus( "Valid" );
+            object.automatic_state = ObjectAutomaticState::Valid;
+            object.automatic_status = ObjectAutomaticStatus::Valid;
 
             /* Tag object for blurring */
             if( ymltype == YMLType::Detector )
-            object->setBlurred( true );
+            object.blurred = true;
 
         } else {
 
             /* Set automatic state as invalid */
-            object->setObjectAutomaticState( ObjectAutomaticState::Invalid );
+            object.automatic_state = ObjectAutomaticState::Invalid;
 
             /* Restore automatic status */
             switch(ymltype)
@@ -350,77 +414,62 @@ ObjectRect* YMLParser::readItem(cv::FileNodeIterator iterator, int ymltype)
             case YMLType::Detector:
 
                 /* Assign proper automatic filtering flag */
-                if( lowerAutoStatus == "filtered-ratio" )
+                if( tagIs( item.auto_status, "filtered-ratio" ) )
                 {
-                   object->setAutomaticStatus( "Ratio" );
-                } else if( lowerAutoStatus == "filtered-size" ){
-                   object->setAutomaticStatus( "Size" );
-                } else if( lowerAutoStatus == "filtered-ratio-size" ){
-                    object->setAutomaticStatus( "Ratio-Size" );
+                   object.automatic_status = ObjectAutomaticStatus::Ratio;
+                } else if( tagIs( item.auto_status, "filtered-size" ) ){
+                   object.automatic_status = ObjectAutomaticStatus::Size;
+                } else if( tagIs( item.auto_status, "filtered-ratio-size" ) ){
+                    object.automatic_status = ObjectAutomaticStatus::RatioSize;
                 }
                 break;
             case YMLType::Validator:
 
                 /* Assign proper automatic filtering flag */
-                if( lowerAutoStatus == "ratio" )
-                {
-                   object->setAutomaticStatus( "Ratio" );
-                } else if( lowerAutoStatus == "size" ){
-                   object->setAutomaticStatus( "Size" );
-                } else if( lowerAutoStatus == "ratio-size" ){
-                    object->setAutomaticStatus( "Ratio-Size" );
-                } else if( lowerAutoStatus == "missingoption" ){
-                    object->setAutomaticStatus( "MissingOption" );
-                }
+                object.automatic_status = ObjectRecord::parseAutomaticStatus( item.auto_status );
                 break;
             }
         }
     } else {
-        object->setObjectAutomaticState( ObjectAutomaticState::Manual );
+        object.automatic_state = ObjectAutomaticState::Manual;
     }
 
-    /* Set automatic status to none if null */
-    object->setAutomaticStatus( (object->getAutomaticStatus().length() > 0 ? object->getAutomaticStatus() : "None") );
-
-    /* Parse manual status */
-    std::string manualStatus;
-    (*iterator)["manualStatus"] >> manualStatus;
-    object->setManualStatus( QString(manualStatus.c_str()) );
-    object->setManualStatus( (object->getManualStatus().length() > 0 ? object->getManualStatus() : "None") );
+    /* Assign manual status */
+    object.manual_status = ObjectRecord::parseManualStatus( item.manual_status );
 
     /* Restore manual status tag */
     /* Check if object is tagged as falsePositive */
-    if(lowerFalsePositive == "no")
+    if(tagIs( item.false_positive, "no" ))
     {
         /* CHeck if object is manual */
-        if(lowerAutoStatus == "none")
+        if(manual)
         {
-            object->setManualStatus("Valid");
+            object.manual_status = ObjectManualStatus::Valid;
         }
-    } else if( lowerFalsePositive == "yes" )
+    } else if( tagIs( item.false_positive, "yes" ) )
     {
-        object->setManualStatus("Invalid");
+        object.manual_status = ObjectManualStatus::Invalid;
     }
 
     /* Restore manual state */
     /* Check if object is a "ToBlur" element */
-    if(object->getObjectType() == ObjectType::ToBlur)
+    if(object.type == ObjectType::ToBlur)
     {
-        object->setObjectManualState( ObjectManualState::ToBlur );
+        object.manual_state = ObjectManualState::ToBlur;
     } else {
 
         /* Check if object is manual */
-        if(object->getManualStatus() != "None")
+        if(object.manual_status != ObjectManualStatus::None)
         {
             /* CHeck if object manual state is valid */
-            if(object->getManualStatus() == "Valid")
+            if(object.manual_status == ObjectManualStatus::Valid)
             {
-                object->setObjectManualState( ObjectManualState::Valid );
+                object.manual_state = ObjectManualState::Valid;
             } else {
-                object->setObjectManualState( ObjectManualState::Invalid );
+                object.manual_state = ObjectManualState::Invalid;
             }
         } else {
-            object->setObjectManualState( ObjectManualState::None );
+            object.manual_state = ObjectManualState::None;
         }
 
     }
@@ -428,24 +477,15 @@ ObjectRect* YMLParser::readItem(cv::FileNodeIterator iterator, int ymltype)
     /* Restore blur tag */
     if( ymltype == YMLType::Validator )
     {
-        /* Read blur tag */
-        std::string blurObject;
-        (*iterator)["blurObject"] >> blurObject;
-        QString blurObject_lower = QString( blurObject.c_str() ).toLower();
-
         /* Set blur tag */
-        object->setBlurred( blurObject_lower == "yes" ? true : false );
+        object.blurred = tagIs( item.blur_object, "yes" );
     }
 
     /* Load childrens */
-    cv::FileNode childNode = (*iterator)["childrens"];
-    for (cv::FileNodeIterator child = childNode.begin(); child != childNode.end(); ++child) {
-        object->childrens.append( this->readItem( child ) );
+    foreach (const yml_item_struct &child, item.childrens) {
+        object.childrens.append( this->buildItem( child ) );
     }
 
-    /* Disable object resizing */
-    object->setResizeEnabled( false );
-
     /* Return object */
     return object;
 }
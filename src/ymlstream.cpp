@@ -0,0 +1,415 @@
+/*
+ * yafdb-validate - Yafdb validation tool
+ *
+ * Copyright (c) 2014-2015 FOXEL SA - http://foxel.ch
+ * Please read <http://foxel.ch/license> for more information.
+ *
+ *
+ * Author(s):
+ *
+ *      Kevin Velickovic <k.velickovic@foxel.ch>
+ *
+ *
+ * This file is part of the FOXEL project <http://foxel.ch>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * Additional Terms:
+ *
+ *      You are required to preserve legal notices and author attributions in
+ *      that material or in the Appropriate Legal Notices displayed by works
+ *      containing it.
+ *
+ *      You are required to attribute the work as explained in the "Usage and
+ *      Attribution" section of <http://foxel.ch/license>.
+ */
+
+/* Includes */
+#include "ymlstream.h"
+
+/* Function to compare a key with a name */
+static bool keyIs(const char* key, int length, const char* name)
+{
+    /* Compare length then characters */
+    return length == (int) strlen( name ) && memcmp( key, name, length ) == 0;
+}
+
+/* Constructor */
+YMLStreamReader::YMLStreamReader()
+{
+}
+
+/* Function to get shared copy of a repeated string (class / status names) */
+QString YMLStreamReader::intern(const QByteArray &bytes)
+{
+    /* Look for an existing copy */
+    QHash<QByteArray, QString>::const_iterator it = this->strings.constFind( bytes );
+
+    /* Return shared copy */
+    if( it != this->strings.constEnd() )
+        return it.value();
+
+    /* Create copy (key is detached from file buffer) */
+    QString value = QString::fromUtf8( bytes );
+    this->strings.insert( QByteArray( bytes.constData(), bytes.size() ), value );
+
+    /* Return result */
+    return value;
+}
+
+/* Function to parse a scalar value (plain, single or double quoted) */
+QByteArray YMLStreamReader::parseScalar(const char* begin, const char* end)
+{
+    /* Plain scalar (refers to file buffer, no copy) */
+    if( begin == end || ( *begin != '"' && *begin != '\'' ) )
+        return QByteArray::fromRawData( begin, end - begin );
+
+    /* Quote character */
+    char quote = *begin;
+
+    /* Unquoted value */
+    QByteArray value;
+    value.reserve( end - begin );
+
+    /* Iterate over quoted characters */
+    for( const char* c = begin + 1; c < end; c++ )
+    {
+        /* Single quoted escape ('') */
+        if( quote == '\'' && *c == '\'' && c + 1 < end && c[1] == '\'' )
+        {
+            value.append( '\'' );
+            c++;
+
+        /* Double quoted escapes */
+        } else if( quote == '"' && *c == '\\' && c + 1 < end ) {
+
+            /* Escaped character */
+            c++;
+            value.append( *c == 'n' ? '\n' : ( *c == 't' ? '\t' : *c ) );
+
+        /* Closing quote */
+        } else if( *c == quote ) {
+            break;
+
+        /* Regular character */
+        } else {
+            value.append( *c );
+        }
+    }
+
+    /* Return result */
+    return value;
+}
+
+/* Function to parse a float value */
+bool YMLStreamReader::parseFloat(const char* begin, const char* end, float* value)
+{
+    /* Conversion result */
+    bool ok = false;
+
+    /* Trim spaces */
+    while( begin < end && *begin == ' ' )
+        begin++;
+    while( end > begin && end[-1] == ' ' )
+        end--;
+
+    /* Convert value (locale independent) */
+    *value = QByteArray::fromRawData( begin, end - begin ).toFloat( &ok );
+
+    /* Return result */
+    return ok;
+}
+
+/* Function to parse a "[ x, y ]" point value */
+bool YMLStreamReader::parsePoint(const char* begin, const char* end, QPointF* point)
+{
+    /* Check brackets */
+    if( end - begin < 2 || *begin != '[' || end[-1] != ']' )
+        return false;
+
+    /* Find separator */
+    const char* comma = (const char*) memchr( begin, ',', end - begin );
+
+    /* Check separator */
+    if( comma == NULL )
+        return false;
+
+    /* Coordinates */
+    float x = 0.0;
+    float y = 0.0;
+
+    /* Parse coordinates */
+    if( !this->parseFloat( begin + 1, comma, &x ) || !this->parseFloat( comma + 1, end - 1, &y ) )
+        return false;
+
+    /* Assign point */
+    *point = QPointF( x, y );
+
+    /* Return result */
+    return true;
+}
+
+/* Function to parse one "key: value" entry in current block */
+bool YMLStreamReader::parseEntry(const char* begin, const char* end, int indent, yml_document_struct* document)
+{
+    /* Current block */
+    Frame top = this->frames.last();
+
+    /* Content of ignored blocks is skipped */
+    if( top.type == Frame::Ignore )
+        return true;
+
+    /* Find key separator (colon followed by space or end of line) */
+    const char* colon = begin;
+    while( colon < end && !( *colon == ':' && ( colon + 1 == end || colon[1] == ' ' ) ) )
+        colon++;
+
+    /* Entries are only expected in mappings */
+    if( colon == end || top.type == Frame::Objects )
+        return false;
+
+    /* Key */
+    const char* key = begin;
+    int length = colon - begin;
+    while( length > 0 && key[length - 1] == ' ' )
+        length--;
+
+    /* Value */
+    const char* value = colon + 1;
+    while( value < end && *value == ' ' )
+        value++;
+
+    /* Block opened on following lines (nested block or block scalar) */
+    bool block = value == end || *value == '|' || *value == '>';
+
+    /* Multi-line flow collections are left to OpenCV storage */
+    if( !block && ( ( *value == '{' && end[-1] != '}' ) || ( *value == '[' && end[-1] != ']' ) ) )
+        return false;
+
+    /* New block */
+    Frame frame;
+    frame.indent = indent;
+    frame.type = Frame::Ignore;
+    frame.objects = NULL;
+    frame.object = top.object;
+
+    /* Block type switch */
+    switch( top.type )
+    {
+
+    /* Document root */
+    case Frame::Root:
+
+        /* Source image path */
+        if( keyIs( key, length, "source_image" ) )
+        {
+            document->source_image = QString::fromUtf8( this->parseScalar( value, end ) );
+            return true;
+        }
+
+        /* Objects sequences */
+        if( keyIs( key, length, "objects" ) )
+        {
+            frame.type = Frame::Objects;
+            frame.objects = &document->objects;
+
+        } else if( keyIs( key, length, "invalidObjects" ) ) {
+            frame.type = Frame::Objects;
+            frame.objects = &document->invalid_objects;
+        }
+        break;
+
+    /* Object mapping */
+    case Frame::Object:
+
+        /* Tags (interned, a few distinct values shared by all objects) */
+        if( keyIs( key, length, "className" ) ) { top.object->class_name = this->intern( this->parseScalar( value, end ) ); return true; }
+        if( keyIs( key, length, "subClassName" ) ) { top.object->sub_class_name = this->intern( this->parseScalar( value, end ) ); return true; }
+        if( keyIs( key, length, "autoStatus" ) ) { top.object->auto_status = this->intern( this->parseScalar( value, end ) ); return true; }
+        if( keyIs( key, length, "manualStatus" ) ) { top.object->manual_status = this->intern( this->parseScalar( value, end ) ); return true; }
+        if( keyIs( key, length, "falsePositive" ) ) { top.object->false_positive = this->intern( this->parseScalar( value, end ) ); return true; }
+        if( keyIs( key, length, "blurObject" ) ) { top.object->blur_object = this->intern( this->parseScalar( value, end ) ); return true; }
+
+        /* Nested blocks */
+        if( keyIs( key, length, "area" ) )
+        {
+            frame.type = Frame::Area;
+
+        } else if( keyIs( key, length, "params" ) ) {
+            frame.type = Frame::Params;
+
+        } else if( keyIs( key, length, "childrens" ) ) {
+            frame.type = Frame::Objects;
+            frame.objects = &top.object->childrens;
+        }
+        break;
+
+    /* Area points */
+    case Frame::Area:
+
+        /* Points p1 - p4 */
+        if( length == 2 && key[0] == 'p' && key[1] >= '1' && key[1] <= '4' )
+            return this->parsePoint( value, end, &top.object->points[ key[1] - '1' ] );
+        break;
+
+    /* Projection parameters */
+    case Frame::Params:
+
+        /* Parameters */
+        if( keyIs( key, length, "azimuth" ) ) return this->parseFloat( value, end, &top.object->azimuth );
+        if( keyIs( key, length, "elevation" ) ) return this->parseFloat( value, end, &top.object->elevation );
+        if( keyIs( key, length, "aperture" ) ) return this->parseFloat( value, end, &top.object->aperture );
+        if( keyIs( key, length, "width" ) ) return this->parseFloat( value, end, &top.object->width );
+        if( keyIs( key, length, "height" ) ) return this->parseFloat( value, end, &top.object->height );
+        break;
+    }
+
+    /* Inline value of an unknown key, or empty sequence */
+    if( !block )
+        return frame.type == Frame::Ignore || ( frame.type == Frame::Objects && keyIs( value, end - value, "[]" ) );
+
+    /* Open block */
+    this->frames.append( frame );
+
+    /* Return result */
+    return true;
+}
+
+/* Function to read a YML file, false if file or layout is not supported */
+bool YMLStreamReader::read(QString path, yml_document_struct* document)
+{
+    /* YML file */
+    QFile file( path );
+
+    /* Open file */
+    if( !file.open( QIODevice::ReadOnly ) )
+        return false;
+
+    /* Read whole file at once */
+    QByteArray data = file.readAll();
+
+    /* Initialize blocks with document root */
+    Frame root;
+    root.indent = -1;
+    root.type = Frame::Root;
+    root.objects = NULL;
+    root.object = NULL;
+
+    this->frames.clear();
+    this->frames.append( root );
+
+    /* Read cursor */
+    const char* cursor = data.constData();
+    const char* data_end = cursor + data.size();
+
+    /* Iterate over lines */
+    while( cursor < data_end )
+    {
+        /* Line bounds */
+        const char* line = cursor;
+        const char* end = (const char*) memchr( cursor, '\n', data_end - cursor );
+        end = end ? end : data_end;
+        cursor = end + 1;
+
+        /* Trim carriage return and trailing spaces */
+        while( end > line && ( end[-1] == '\r' || end[-1] == ' ' ) )
+            end--;
+
+        /* Skip indentation */
+        const char* begin = line;
+        while( begin < end && *begin == ' ' )
+            begin++;
+
+        /* Indentation width */
+        int indent = begin - line;
+
+        /* Skip empty lines, comments, directives and document markers */
+        if( begin == end || *begin == '#' || *begin == '%' || ( end - begin >= 3 && ( memcmp( begin, "---", 3 ) == 0 || memcmp( begin, "...", 3 ) == 0 ) ) )
+            continue;
+
+        /* Sequence item line */
+        bool dash = *begin == '-' && ( begin + 1 == end || begin[1] == ' ' );
+
+        /* Close blocks ending before this line */
+        while( this->frames.size() > 1 )
+        {
+            /* Current block */
+            const Frame &top = this->frames.last();
+
+            /* Line is inside current block */
+            if( indent > top.indent )
+                break;
+
+            /* Sequence items may be written at the key indentation */
+            if( dash && indent == top.indent && ( top.type == Frame::Objects || top.type == Frame::Ignore ) )
+                break;
+
+            /* Close block */
+            this->frames.removeLast();
+        }
+
+        /* Sequence item */
+        if( dash )
+        {
+            /* Current block */
+            Frame top = this->frames.last();
+
+            /* Item block */
+            Frame item;
+            item.indent = indent;
+            item.type = Frame::Ignore;
+            item.objects = NULL;
+            item.object = NULL;
+
+            /* New object */
+            if( top.type == Frame::Objects )
+            {
+                top.objects->append( yml_item_struct() );
+                item.type = Frame::Object;
+                item.object = &top.objects->last();
+
+            /* Items are only expected in sequences */
+            } else if( top.type != Frame::Ignore ) {
+                return false;
+            }
+
+            /* Open item */
+            this->frames.append( item );
+
+            /* Skip dash */
+            begin++;
+            while( begin < end && *begin == ' ' )
+                begin++;
+
+            /* Item content starts on next line */
+            if( begin == end )
+                continue;
+
+            /* Flow collection items are left to OpenCV storage */
+            if( *begin == '{' || *begin == '[' )
+                return false;
+
+            /* Item first entry is on dash line */
+            indent = begin - line;
+        }
+
+        /* Parse entry */
+        if( !this->parseEntry( begin, end, indent, document ) )
+            return false;
+    }
+
+    /* Return result */
+    return true;
+}
@@ -0,0 +1,22 @@
+#-------------------------------------------------
+#
+# Settings shared by core library and applications
+#
+#-------------------------------------------------
+
+# Compiler flags
+QMAKE_CXXFLAGS += -fopenmp
+
+# Include directories
+INCLUDEPATH += $$PWD/include/ \
+    $$PWD/libs/libgnomonic/lib/libinter/src/ \
+    $$PWD/libs/libgnomonic/src/
+
+# Core library location
+YAFDB_CORE_LIB = $$OUT_PWD/../core/libyafdb-core.a
+
+# Core library and its dependencies (order matters for static linking)
+YAFDB_CORE_LIBS = $$YAFDB_CORE_LIB \
+    $$PWD/libs/libgnomonic/lib/libinter/bin/libinter.a \
+    $$PWD/libs/libgnomonic/bin/libgnomonic.a \
+    -fopenmp